@@ -0,0 +1,163 @@
+/**
+ * MIT License
+ * Copyright (c) 2024 Markus Iser
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <functional>
+#include <map>
+#include <string>
+#include <vector>
+
+/**
+ * Minimal micro-benchmark harness in the spirit of Google Benchmark:
+ *
+ *   BENCHMARK(name) { setup(); for (auto _ : state) { work(); } }
+ *
+ * Every benchmark body is executed repeatedly with growing iteration counts until
+ * the timed loop runs for at least `min_time` seconds. Reported is the time per iteration.
+ */
+namespace bench {
+
+inline void do_not_optimize(const void* p) {
+    asm volatile("" : : "g"(p) : "memory");
+}
+
+template <typename T>
+inline void do_not_optimize(const T& value) {
+    do_not_optimize(static_cast<const void*>(&value));
+}
+
+class State {
+    uint64_t iterations_;
+    uint64_t items_ = 0;
+    size_t peak_bytes_ = 0;
+    std::map<std::string, double> counters_;
+    std::chrono::steady_clock::time_point start_, stop_;
+
+ public:
+    // loop variable of for (auto _ : state), unused by design
+    struct [[maybe_unused]] Value { };
+
+    struct Iterator {
+        State* state;
+        uint64_t remaining;
+
+        bool operator!=(const Iterator&) {
+            if (remaining-- > 0) return true;
+            state->stop_ = std::chrono::steady_clock::now();
+            return false;
+        }
+        void operator++() { }
+        Value operator*() const { return Value(); }
+    };
+
+    explicit State(uint64_t iterations) : iterations_(iterations) { }
+
+    Iterator begin() {
+        start_ = std::chrono::steady_clock::now();
+        return Iterator { this, iterations_ };
+    }
+
+    Iterator end() {
+        return Iterator { this, 0 };
+    }
+
+    // number of processed items per iteration (literals, clauses, ...), used to report throughput
+    void setItemsProcessed(uint64_t items) {
+        items_ = items;
+    }
+
+    // peak memory of an iteration, e.g. the peak of a ResourceBudget, reported if set
+    void setPeakBytes(size_t bytes) {
+        peak_bytes_ = std::max(peak_bytes_, bytes);
+    }
+
+    // user counter of an iteration (e.g. recognized gates), reported next to the timings
+    void setCounter(const std::string& name, double value) {
+        counters_[name] = value;
+    }
+
+    uint64_t iterations() const {
+        return iterations_;
+    }
+
+    uint64_t items() const {
+        return items_;
+    }
+
+    size_t peakBytes() const {
+        return peak_bytes_;
+    }
+
+    const std::map<std::string, double>& counters() const {
+        return counters_;
+    }
+
+    double seconds() const {
+        return std::chrono::duration<double>(stop_ - start_).count();
+    }
+};
+
+struct Benchmark {
+    std::string name;
+    std::function<void(State&)> function;
+};
+
+struct Result {
+    std::string name;
+    uint64_t iterations;
+    double ns_per_iteration;
+    double items_per_second;
+    size_t peak_bytes;
+    std::map<std::string, double> counters;
+};
+
+// directory of benchmark instances, defaults to the test resources in the build tree
+inline std::string& resource_dir() {
+    static std::string dir = "test/resources/test_files/";
+    return dir;
+}
+
+inline std::string resource(const std::string& filename) {
+    return resource_dir() + filename;
+}
+
+inline std::vector<Benchmark>& registry() {
+    static std::vector<Benchmark> benchmarks;
+    return benchmarks;
+}
+
+struct Registrar {
+    Registrar(const char* name, void (*function)(State&)) {
+        registry().push_back({ name, function });
+    }
+};
+
+inline Result run(const Benchmark& benchmark, double min_time) {
+    uint64_t iterations = 1;
+    while (true) {
+        State state(iterations);
+        benchmark.function(state);
+        double seconds = state.seconds();
+        if (seconds >= min_time || iterations >= (1ULL << 30)) {
+            double items = static_cast<double>(state.items()) * iterations;
+            return Result { benchmark.name, iterations, 1e9 * seconds / iterations, seconds > 0 ? items / seconds : 0, state.peakBytes(), state.counters() };
+        }
+        // extrapolate required iterations from the last run, grow at most tenfold
+        double factor = seconds > 0 ? 1.4 * min_time / seconds : 10;
+        iterations = static_cast<uint64_t>(iterations * std::min(std::max(factor, 2.0), 10.0));
+    }
+}
+
+}  // namespace bench
+
+#define BENCHMARK(name) \
+    static void name(bench::State& state); \
+    static bench::Registrar name##_registrar(#name, name); \
+    static void name(bench::State& state)
@@ -0,0 +1,105 @@
+/**
+ * MIT License
+ * Copyright (c) 2024 Markus Iser
+ */
+
+#include <algorithm>
+#include <numeric>
+#include <string>
+#include <vector>
+
+#include "bench/Bench.h"
+
+#include "src/util/SolverTypes.h"
+#include "src/util/CNFFormula.h"
+#include "src/extract/CNFBaseFeatures.h"
+#include "src/extract/gates/OccurrenceList.h"
+
+static const char* instance = "cnf_test.cnf.xz";
+
+static size_t count_literals(const CNFFormula& formula) {
+    size_t n = 0;
+    for (const Cl* clause : formula) n += clause->size();
+    return n;
+}
+
+// Copy of literal vectors, trivially copyable Lit allows memmove
+BENCHMARK(SolverTypes_CopyClauses) {
+    CNFFormula formula(bench::resource(instance).c_str());
+    std::vector<Cl> copies(formula.nClauses());
+    for (auto _ : state) {
+        for (size_t i = 0; i < formula.nClauses(); ++i) {
+            copies[i] = *formula[i];
+        }
+        bench::do_not_optimize(copies.data());
+    }
+    state.setItemsProcessed(count_literals(formula));
+}
+
+// Hot loop of CNF::BaseFeatures1: literal occurrence counting with on-demand growth
+BENCHMARK(SolverTypes_LiteralOccurrences) {
+    CNFFormula formula(bench::resource(instance).c_str());
+    std::vector<unsigned> occurrences(2 * formula.nVars() + 2);
+    for (auto _ : state) {
+        std::fill(occurrences.begin(), occurrences.end(), 0);
+        for (const Cl* clause : formula) {
+            for (Lit lit : *clause) ++occurrences[lit];
+        }
+        bench::do_not_optimize(occurrences.data());
+    }
+    state.setItemsProcessed(count_literals(formula));
+}
+
+BENCHMARK(CNFBaseFeatures1_Extract) {
+    const std::string filename = bench::resource(instance);
+    for (auto _ : state) {
+        CNF::BaseFeatures1 extractor(filename.c_str());
+        extractor.extract();
+        bench::do_not_optimize(extractor.getFeatures().data());
+    }
+}
+
+BENCHMARK(CNFBaseFeatures2_Extract) {
+    const std::string filename = bench::resource(instance);
+    for (auto _ : state) {
+        CNF::BaseFeatures2 extractor(filename.c_str());
+        extractor.extract();
+        bench::do_not_optimize(extractor.getFeatures().data());
+    }
+}
+
+BENCHMARK(OccurrenceList_Build) {
+    CNFFormula formula(bench::resource(instance).c_str());
+    for (auto _ : state) {
+        OccurrenceList index(formula);
+        bench::do_not_optimize(index.size());
+    }
+    state.setItemsProcessed(count_literals(formula));
+}
+
+BENCHMARK(OccurrenceList_IsBlockedSet) {
+    CNFFormula formula(bench::resource(instance).c_str());
+    OccurrenceList index(formula);
+    for (auto _ : state) {
+        unsigned blocked = 0;
+        for (unsigned lit = 2; lit < index.size(); ++lit) {
+            blocked += index.isBlockedSet(Lit(lit >> 1, lit & 1));
+        }
+        bench::do_not_optimize(blocked);
+    }
+    state.setItemsProcessed(index.size() - 2);
+}
+
+// Root estimation drains the index clause by clause through OccurrenceList::remove
+BENCHMARK(OccurrenceList_EstimateRoots) {
+    CNFFormula formula(bench::resource(instance).c_str());
+    for (auto _ : state) {
+        OccurrenceList index(formula);
+        size_t n = 0;
+        for (For roots = index.estimateRoots(); !roots.empty(); roots = index.estimateRoots()) {
+            n += roots.size();
+        }
+        bench::do_not_optimize(n);
+    }
+    state.setItemsProcessed(formula.nClauses());
+}
@@ -0,0 +1,112 @@
+/**
+ * MIT License
+ * Copyright (c) 2024 Markus Iser
+ */
+
+#include <algorithm>
+#include <filesystem>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "bench/Bench.h"
+
+#include "src/extract/CNFBaseFeatures.h"
+#include "src/extract/CNFGateFeatures.h"
+#include "src/extract/WCNFBaseFeatures.h"
+#include "src/extract/OPBBaseFeatures.h"
+#include "src/extract/gates/GateAnalyzer.h"
+#include "src/util/ResourceBudget.h"
+#include "src/identify/GBDHash.h"
+
+// all benchmark instances with the given extension (e.g. ".cnf.xz"), sorted by name
+static std::vector<std::string> instances(const std::string& extension) {
+    std::vector<std::string> result;
+    for (const auto& entry : std::filesystem::directory_iterator(bench::resource_dir())) {
+        std::string path = entry.path().string();
+        if (path.size() >= extension.size() && path.compare(path.size() - extension.size(), extension.size(), extension) == 0) {
+            result.push_back(path);
+        }
+    }
+    std::sort(result.begin(), result.end());
+    return result;
+}
+
+// one iteration extracts the features of all instances of the given type
+template <typename Extractor>
+static void extract_all(bench::State& state, const std::string& extension) {
+    const std::vector<std::string> files = instances(extension);
+    for (auto _ : state) {
+        for (const std::string& file : files) {
+            Extractor extractor(file.c_str());
+            extractor.extract();
+            bench::do_not_optimize(extractor.getFeatures().data());
+        }
+    }
+    state.setItemsProcessed(files.size());
+}
+
+BENCHMARK(Extract_CNFBaseFeatures) {
+    extract_all<CNF::BaseFeatures>(state, ".cnf.xz");
+}
+
+BENCHMARK(Extract_CNFGateFeatures) {
+    extract_all<CNF::GateFeatures>(state, ".cnf.xz");
+}
+
+BENCHMARK(Extract_WCNFBaseFeatures) {
+    extract_all<WCNF::BaseFeatures>(state, ".wcnf.xz");
+}
+
+BENCHMARK(Extract_OPBBaseFeatures) {
+    extract_all<OPB::BaseFeatures>(state, ".opb.xz");
+}
+
+// gate analysis as in CNF::GateFeatures with the given index backend, instances are parsed outside of the timed loop,
+// analysis of a single instance is cut off after 10 seconds, reports the gates of completed analyses and the number of timeouts
+template <typename Index>
+static void analyze_all(bench::State& state) {
+    std::vector<std::unique_ptr<CNFFormula>> formulas;
+    for (const std::string& file : instances(".cnf.xz")) formulas.emplace_back(new CNFFormula(file.c_str()));
+    unsigned gates = 0, timeouts = 0;
+    for (auto _ : state) {
+        gates = timeouts = 0;
+        for (const auto& formula : formulas) {
+            ResourceBudget budget(10);
+            ResourceBudget::Scope scope(budget);
+            try {
+                GateAnalyzer<Index> analyzer(*formula, true, true, formula->nVars() / 3);
+                analyzer.analyze();
+                gates += analyzer.getGateFormula().nGates();
+            } catch (const TimeLimitExceeded&) {
+                ++timeouts;
+            }
+        }
+    }
+    state.setItemsProcessed(formulas.size());
+    state.setCounter("gates", gates);
+    state.setCounter("timeouts", timeouts);
+}
+
+BENCHMARK(GateAnalyzer_OccurrenceList) {
+    analyze_all<OccurrenceList>(state);
+}
+
+BENCHMARK(GateAnalyzer_BlockList) {
+    analyze_all<BlockList>(state);
+}
+
+// root selection by priority queue, compare gates and runtime with GateAnalyzer_OccurrenceList
+BENCHMARK(GateAnalyzer_PriorityOccurrenceList) {
+    analyze_all<PriorityOccurrenceList>(state);
+}
+
+BENCHMARK(Identify_GBDHash) {
+    const std::vector<std::string> files = instances(".cnf.xz");
+    for (auto _ : state) {
+        for (const std::string& file : files) {
+            bench::do_not_optimize(CNF::gbdhash(file.c_str()));
+        }
+    }
+    state.setItemsProcessed(files.size());
+}
@@ -0,0 +1,130 @@
+/**
+ * MIT License
+ * Copyright (c) 2024 Markus Iser
+ */
+
+#include <algorithm>
+#include <cstdint>
+#include <filesystem>
+#include <functional>
+#include <set>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "bench/Bench.h"
+
+#include "src/generate/Generators.h"
+#include "src/util/CNFFormula.h"
+#include "src/util/ResourceBudget.h"
+#include "src/extract/CNFBaseFeatures.h"
+#include "src/extract/CNFGateFeatures.h"
+#include "src/extract/WCNFBaseFeatures.h"
+#include "src/extract/OPBBaseFeatures.h"
+#include "src/extract/gates/GateAnalyzer.h"
+
+/**
+ * Throughput and peak memory at increasing instance sizes on generated instances (see src/generate).
+ * Instances are generated once per run into the temporary directory, generation is not timed.
+ * Peak memory is the peak of the memory accounted by a ResourceBudget (clause storage, occurrence lists, ...).
+ */
+
+static const uint64_t sizes[] = { 10000, 100000, 1000000 };  // clauses or constraints
+static const uint64_t mux_sizes[] = { 1000, 3000, 10000 };  // gates
+
+static std::string scaled_instance(const std::string& type, uint64_t size, const std::string& extension) {
+    static std::set<std::string> generated;
+    std::string path = (std::filesystem::temp_directory_path() / ("gbdc_bench_" + type + "_" + std::to_string(size) + extension)).string();
+    if (generated.insert(path).second) {
+        generate::Parameters p;
+        p.clauses = size;
+        p.vars = static_cast<unsigned>(size / 4.2);
+        p.communities = static_cast<unsigned>(p.vars / 50);
+        p.inputs = static_cast<unsigned>(size / 30);
+        p.gates = static_cast<unsigned>(size / 3);
+        p.soft = size / 10;
+        InstanceWriter out(path.c_str());
+        generate::write(type, p, out);
+    }
+    return path;
+}
+
+// circuit of wide multiplexers (see generate::TseitinCircuit) with outputs asserted if without fanout,
+// seven inputs are too many for truth tables such that each gate takes propagation or a SAT call
+static std::string wide_mux_instance(uint64_t size) {
+    std::string path = (std::filesystem::temp_directory_path() / ("gbdc_bench_widemux_" + std::to_string(size) + ".cnf")).string();
+    generate::Parameters p;
+    p.inputs = static_cast<unsigned>(size / 10);
+    p.gates = static_cast<unsigned>(size);
+    p.wide_mux_ratio = 1;
+    p.window = p.inputs + p.gates;
+    InstanceWriter out(path.c_str());
+    generate::write("circuit", p, out);
+    out.close();
+    return path;
+}
+
+// one iteration runs the given job on the instance under a fresh budget
+static void measure(bench::State& state, const std::string& path, uint64_t items, const std::function<void(const char*)>& job) {
+    for (auto _ : state) {
+        ResourceBudget budget;
+        ResourceBudget::Scope scope(budget);
+        job(path.c_str());
+        state.setPeakBytes(budget.peak());
+    }
+    state.setItemsProcessed(items);
+}
+
+template <typename Extractor>
+static void extract(const char* path) {
+    Extractor extractor(path);
+    extractor.extract();
+    bench::do_not_optimize(extractor.getFeatures().data());
+}
+
+static const bool registered = [] () {
+    for (uint64_t size : sizes) {
+        std::string suffix = "/" + std::to_string(size);
+        bench::registry().push_back({ "Scale_CNFFormula" + suffix, [size] (bench::State& state) {
+            measure(state, scaled_instance("kcnf", size, ".cnf"), size, [] (const char* path) {
+                CNFFormula formula(path);
+                bench::do_not_optimize(formula.nClauses());
+            });
+        } });
+        bench::registry().push_back({ "Scale_CNFBaseFeatures" + suffix, [size] (bench::State& state) {
+            measure(state, scaled_instance("community", size, ".cnf"), size, extract<CNF::BaseFeatures>);
+        } });
+        bench::registry().push_back({ "Scale_CNFGateFeatures" + suffix, [size] (bench::State& state) {
+            measure(state, scaled_instance("circuit", size, ".cnf"), size, extract<CNF::GateFeatures>);
+        } });
+        bench::registry().push_back({ "Scale_WCNFBaseFeatures" + suffix, [size] (bench::State& state) {
+            measure(state, scaled_instance("wcnf", size, ".wcnf"), size, extract<WCNF::BaseFeatures>);
+        } });
+        bench::registry().push_back({ "Scale_OPBBaseFeatures" + suffix, [size] (bench::State& state) {
+            measure(state, scaled_instance("opb", size, ".opb"), size, extract<OPB::BaseFeatures>);
+        } });
+    }
+    // multiplexers of conjunctions are recognized by semantic checks only, by propagation or one incremental SAT call per gate,
+    // generation is not timed such that the time per check is visible,
+    // the parallel variant checks the candidates of each level on a pool of one solver per hardware thread
+    for (uint64_t size : mux_sizes) {
+        for (bool parallel : { false, true }) {
+            std::string name = parallel ? "Scale_SemanticChecks_Parallel/" : "Scale_SemanticChecks/";
+            bench::registry().push_back({ name + std::to_string(size), [size, parallel] (bench::State& state) {
+                CNFFormula formula(wide_mux_instance(size).c_str());
+                unsigned threads = parallel ? std::max(1U, std::thread::hardware_concurrency()) : 1;
+                for (auto _ : state) {
+                    ResourceBudget budget;
+                    ResourceBudget::Scope scope(budget);
+                    GateAnalyzer<> analyzer(formula, true, true, formula.nVars() / 3, 0, threads);
+                    analyzer.analyze();
+                    bench::do_not_optimize(analyzer.getGateFormula().nGates());
+                    state.setPeakBytes(budget.peak());
+                    state.setCounter("gates", analyzer.getGateFormula().nGates());
+                }
+                state.setItemsProcessed(size);
+            } });
+        }
+    }
+    return true;
+}();
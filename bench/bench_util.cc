@@ -0,0 +1,96 @@
+/**
+ * MIT License
+ * Copyright (c) 2024 Markus Iser
+ */
+
+#include <cstdint>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "bench/Bench.h"
+
+#include "src/util/SolverTypes.h"
+#include "src/util/CNFFormula.h"
+#include "src/util/StreamBuffer.h"
+#include "src/util/CaptureDistribution.h"
+#include "src/util/UnionFind.h"
+#include "src/external/md5/md5.h"
+
+static const char* instance = "cnf_test.cnf.xz";
+
+// Tokenizer throughput including decompression of the xz input
+BENCHMARK(StreamBuffer_ReadInteger) {
+    const std::string filename = bench::resource(instance);
+    uint64_t tokens = 0;
+    for (auto _ : state) {
+        StreamBuffer in(filename.c_str());
+        tokens = 0;
+        int plit;
+        while (in.skipWhitespace()) {
+            if (*in == 'p' || *in == 'c') {
+                if (!in.skipLine()) break;
+            } else {
+                while (in.readInteger(&plit)) ++tokens;
+            }
+        }
+        bench::do_not_optimize(tokens);
+    }
+    state.setItemsProcessed(tokens);
+}
+
+BENCHMARK(StreamBuffer_ReadClause) {
+    const std::string filename = bench::resource(instance);
+    uint64_t clauses = 0;
+    for (auto _ : state) {
+        StreamBuffer in(filename.c_str());
+        Cl clause;
+        clauses = 0;
+        while (in.readClause(clause)) ++clauses;
+        bench::do_not_optimize(clauses);
+    }
+    state.setItemsProcessed(clauses);
+}
+
+// Consume path of gbdhash: one call per token and separator
+BENCHMARK(MD5_Consume) {
+    std::vector<std::string> tokens;
+    std::mt19937 rng(42);
+    std::uniform_int_distribution<int> lits(-100000, 100000);
+    for (unsigned i = 0; i < 1 << 16; ++i) tokens.push_back(std::to_string(lits(rng)));
+    uint64_t bytes = 0;
+    for (const std::string& token : tokens) bytes += token.length() + 1;
+    for (auto _ : state) {
+        MD5 md5;
+        for (const std::string& token : tokens) {
+            md5.consume(token.c_str(), token.length());
+            md5.consume(" ", 1);
+        }
+        bench::do_not_optimize(md5.produce());
+    }
+    state.setItemsProcessed(bytes);
+}
+
+BENCHMARK(CaptureDistribution_PushDistribution) {
+    std::vector<unsigned> distribution(1 << 16);
+    std::mt19937 rng(42);
+    std::geometric_distribution<unsigned> degrees(0.1);
+    for (unsigned& value : distribution) value = degrees(rng);
+    for (auto _ : state) {
+        std::vector<double> record;
+        push_distribution(record, distribution);
+        bench::do_not_optimize(record.data());
+    }
+    state.setItemsProcessed(distribution.size());
+}
+
+// Connected components of the variable incidence graph as in CNF::BaseFeatures1
+BENCHMARK(UnionFind_Insert) {
+    CNFFormula formula(bench::resource(instance).c_str());
+    for (auto _ : state) {
+        UnionFind uf;
+        for (const Cl* clause : formula) uf.insert(*clause);
+        bench::do_not_optimize(uf);
+    }
+    state.setItemsProcessed(formula.nClauses());
+}
@@ -0,0 +1,69 @@
+/**
+ * MIT License
+ * Copyright (c) 2024 Markus Iser
+ */
+
+#include <cstdio>
+#include <cstdlib>
+#include <ctime>
+#include <string>
+#include <vector>
+
+#include "bench/Bench.h"
+
+// machine-readable results, field names follow Google Benchmark's JSON output
+static void print_json(const std::vector<bench::Result>& results, double min_time) {
+    char date[64];
+    std::time_t now = std::time(nullptr);
+    std::strftime(date, sizeof(date), "%Y-%m-%dT%H:%M:%S%z", std::localtime(&now));
+    std::printf("{\n  \"context\": {\"date\": \"%s\", \"min_time\": %g, \"resources\": \"%s\"},\n", date, min_time, bench::resource_dir().c_str());
+    std::printf("  \"benchmarks\": [");
+    for (size_t i = 0; i < results.size(); ++i) {
+        const bench::Result& result = results[i];
+        std::printf("%s\n    {\"name\": \"%s\", \"iterations\": %llu, \"real_time\": %.1f, \"time_unit\": \"ns\", \"items_per_second\": %.6g, \"peak_bytes\": %llu",
+            i > 0 ? "," : "", result.name.c_str(), static_cast<unsigned long long>(result.iterations), result.ns_per_iteration, result.items_per_second,
+            static_cast<unsigned long long>(result.peak_bytes));
+        for (const auto& counter : result.counters) std::printf(", \"%s\": %.6g", counter.first.c_str(), counter.second);
+        std::printf("}");
+    }
+    std::printf("\n  ]\n}\n");
+}
+
+int main(int argc, char** argv) {
+    std::string filter = "";
+    double min_time = 0.5;
+    bool json = false;
+
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--min-time" && i + 1 < argc) {
+            min_time = std::atof(argv[++i]);
+        } else if (arg == "--resources" && i + 1 < argc) {
+            bench::resource_dir() = std::string(argv[++i]) + "/";
+        } else if (arg == "--json") {
+            json = true;
+        } else if (arg == "-h" || arg == "--help") {
+            std::printf("Usage: %s [--min-time seconds] [--resources dir] [--json] [filter]\n", argv[0]);
+            return 0;
+        } else {
+            filter = arg;
+        }
+    }
+
+    std::vector<bench::Result> results;
+    if (!json) std::printf("%-40s %14s %16s %14s %12s\n", "Benchmark", "Iterations", "Time/Iteration", "Items/s", "Peak MB");
+    for (const bench::Benchmark& benchmark : bench::registry()) {
+        if (benchmark.name.find(filter) == std::string::npos) continue;
+        bench::Result result = bench::run(benchmark, min_time);
+        results.push_back(result);
+        if (json) continue;
+        char peak[32] = "-";
+        if (result.peak_bytes > 0) std::snprintf(peak, sizeof(peak), "%.1f", result.peak_bytes / 1048576.0);
+        std::printf("%-40s %14llu %13.0f ns %14.4g %12s", result.name.c_str(),
+            static_cast<unsigned long long>(result.iterations), result.ns_per_iteration, result.items_per_second, peak);
+        for (const auto& counter : result.counters) std::printf(" %s=%g", counter.first.c_str(), counter.second);
+        std::printf("\n");
+    }
+    if (json) print_json(results, min_time);
+    return 0;
+}
@@ -0,0 +1,81 @@
+/**
+ * MIT License
+ * Copyright (c) 2024 Markus Iser
+ */
+
+#include <cstdio>
+#include <cstdlib>
+#include <exception>
+#include <string>
+
+#include "src/generate/Generators.h"
+
+static void usage(const char* program) {
+    std::printf("Usage: %s type [options] [-o output]\n", program);
+    std::printf("  type: kcnf, community, circuit, wcnf, opb\n");
+    std::printf("  output: file name, .xz files are compressed, default is stdout\n");
+    std::printf("  options (default):\n");
+    std::printf("    --vars n (1000), --clauses m (4200), --k k (3), --seed s (1)\n");
+    std::printf("    community: --communities c (40), --modularity q (0.8)\n");
+    std::printf("    circuit: --inputs n (100), --gates g (1000), --xor r (0.2), --or r (0.3), --mux r (0), --wide-mux r (0), --window w (200)\n");
+    std::printf("    wcnf: --soft s (1000), --max-weight w (100)\n");
+    std::printf("    opb: --max-coeff c (10)\n");
+}
+
+int main(int argc, char** argv) {
+    if (argc < 2) {
+        usage(argv[0]);
+        return 1;
+    }
+
+    std::string type = argv[1];
+    std::string output = "-";
+    generate::Parameters p;
+
+    for (int i = 2; i < argc; ++i) {
+        std::string arg = argv[i];
+        if ((arg == "-o" || arg == "--output") && i + 1 < argc) {
+            output = argv[++i];
+            continue;
+        } else if (arg == "-h" || arg == "--help") {
+            usage(argv[0]);
+            return 0;
+        } else if (i + 1 == argc) {
+            std::fprintf(stderr, "Missing value or unknown option: %s\n", arg.c_str());
+            return 1;
+        }
+        const char* value = argv[++i];
+        if (arg == "--vars") p.vars = std::strtoul(value, nullptr, 10);
+        else if (arg == "--clauses") p.clauses = std::strtoull(value, nullptr, 10);
+        else if (arg == "--k") p.k = std::strtoul(value, nullptr, 10);
+        else if (arg == "--seed") p.seed = std::strtoull(value, nullptr, 10);
+        else if (arg == "--communities") p.communities = std::strtoul(value, nullptr, 10);
+        else if (arg == "--modularity") p.modularity = std::atof(value);
+        else if (arg == "--inputs") p.inputs = std::strtoul(value, nullptr, 10);
+        else if (arg == "--gates") p.gates = std::strtoul(value, nullptr, 10);
+        else if (arg == "--xor") p.xor_ratio = std::atof(value);
+        else if (arg == "--or") p.or_ratio = std::atof(value);
+        else if (arg == "--mux") p.mux_ratio = std::atof(value);
+        else if (arg == "--wide-mux") p.wide_mux_ratio = std::atof(value);
+        else if (arg == "--window") p.window = std::strtoul(value, nullptr, 10);
+        else if (arg == "--soft") p.soft = std::strtoull(value, nullptr, 10);
+        else if (arg == "--max-weight") p.max_weight = std::strtoull(value, nullptr, 10);
+        else if (arg == "--max-coeff") p.max_coeff = std::strtoull(value, nullptr, 10);
+        else {
+            std::fprintf(stderr, "Unknown option: %s\n", arg.c_str());
+            return 1;
+        }
+    }
+
+    try {
+        InstanceWriter out(output.c_str());
+        generate::write(type, p, out);
+        out.close();
+        if (output != "-") std::fprintf(stderr, "Generated %s (%llu bytes)\n", output.c_str(), static_cast<unsigned long long>(out.size()));
+    }
+    catch (const std::exception& e) {
+        std::fprintf(stderr, "%s\n", e.what());
+        return 1;
+    }
+    return 0;
+}
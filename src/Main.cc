@@ -34,22 +34,25 @@ OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWA
 #include "src/transform/IndependentSet.h"
 #include "src/transform/Normalize.h"
 #include "src/util/ResourceLimits.h"
+#include "src/util/Profile.h"
 #include "src/transform/cnf2bip.h"
 
 #include "src/extract/CNFGateFeatures.h"
 #include "src/extract/CNFBaseFeatures.h"
 #include "src/extract/WCNFBaseFeatures.h"
 #include "src/extract/OPBBaseFeatures.h"
+#include "src/extract/gates/GateAnalyzer.h"
+#include "src/extract/gates/GateFile.h"
 
 #include "src/util/StreamCompressor.h"
 
 int main(int argc, char** argv) {
     argparse::ArgumentParser argparse("CNF Tools");
 
-    argparse.add_argument("tool").help("Select Tool: solve, id|identify (gbdhash, opbhash, pqbfhash), isohash, normalize, sanitize, checksani, cnf2kis, cnf2bip, extract, gates")
+    argparse.add_argument("tool").help("Select Tool: solve, id|identify (gbdhash, opbhash, pqbfhash), isohash, normalize, sanitize, checksani, cnf2kis, cnf2bip, cnf2gates, extract, gates")
         .default_value("identify")
         .action([](const std::string& value) {
-            static const std::vector<std::string> choices = { "solve", "id", "identify", "gbdhash", "opbhash", "pqbfhash", "isohash", "normalize", "sanitize", "checksani", "cnf2kis", "cnf2bip", "extract", "gates", "test" };
+            static const std::vector<std::string> choices = { "solve", "id", "identify", "gbdhash", "opbhash", "pqbfhash", "isohash", "normalize", "sanitize", "checksani", "cnf2kis", "cnf2bip", "cnf2gates", "extract", "gates", "test" };
             if (std::find(choices.begin(), choices.end(), value) != choices.end()) {
                 return value;
             }
@@ -62,6 +65,9 @@ int main(int argc, char** argv) {
     argparse.add_argument("-m", "--memout").default_value(0).scan<'i', int>().help("Memory limit in MB");
     argparse.add_argument("-f", "--fileout").default_value(0).scan<'i', int>().help("File size limit in MB");
     argparse.add_argument("-v", "--verbose").default_value(0).scan<'i', int>().help("Verbosity");
+    argparse.add_argument("-c", "--check-limit").default_value(0.0).scan<'g', double>().help("Time limit of a single semantic gate check in seconds, 0 = unlimited (used by gates)");
+    argparse.add_argument("-r", "--rename").default_value(false).implicit_value(true).help("Rename variables to 1..n in order of first occurrence (used by gates and cnf2gates)");
+    argparse.add_argument("-p", "--profile").default_value(false).implicit_value(true).help("Print profile (phase times, peak memory, counters) as JSON to stderr");
 
     try {
         argparse.parse_args(argc, argv);
@@ -76,11 +82,18 @@ int main(int argc, char** argv) {
     std::string toolname = argparse.get("tool");
     std::string output = argparse.get("output");
     int verbose = argparse.get<int>("verbose");
+    bool rename = argparse.get<bool>("rename");
+    double check_limit = argparse.get<double>("check-limit");
 
     ResourceLimits limits(argparse.get<int>("timeout"), argparse.get<int>("memout"), argparse.get<int>("fileout"));
     limits.set_rlimits();
     std::cerr << "c Running: " << toolname << " " << filename << std::endl;
 
+    bool profiling = argparse.get<bool>("profile");
+    Profile profile;
+    std::unique_ptr<Profile::Scope> profile_scope(profiling ? new Profile::Scope(profile) : nullptr);
+
+    int status = 0;  // the profile is printed on all exit paths
     try {
         if (toolname == "id" || toolname == "identify") {
             std::string ext = std::filesystem::path(filename).extension();
@@ -138,6 +151,16 @@ int main(int argc, char** argv) {
             std::cerr << "Generating Bipartite Graph " << filename << std::endl;
             BipartiteGraphFromCNF gen(filename.c_str());
             gen.generate_bipartite_graph(output == "-" ? nullptr : output.c_str());
+        } else if (toolname == "cnf2gates") {
+            std::cerr << "Writing Gate Structure " << filename << std::endl;
+            CNFFormula formula;
+            formula.enableDeduplication();
+            if (rename) formula.enableRenaming();
+            formula.readDimacsFromFile(filename.c_str());
+            GateAnalyzer<> analyzer(formula, true, true, formula.nVars() / 3);
+            analyzer.analyze();
+            GateWriter writer(output.c_str());
+            writer.write(analyzer.getGateFormula());
         } else if (toolname == "extract") {
             std::string ext = std::filesystem::path(filename).extension();
             if (ext == ".xz" || ext == ".lzma" || ext == ".bz2" || ext == ".gz") {
@@ -172,7 +195,7 @@ int main(int argc, char** argv) {
                 }
             }
         } else if (toolname == "gates") {
-            CNF::GateFeatures stats(filename.c_str());
+            CNF::GateFeatures stats(filename.c_str(), check_limit, rename);
             stats.extract();
             std::vector<double> record = stats.getFeatures();
             std::vector<std::string> names = stats.getNames();
@@ -188,20 +211,24 @@ int main(int argc, char** argv) {
     }
     catch (std::bad_alloc& e) {
         std::cerr << "Memory Limit Exceeded" << std::endl;
-        return 1;
+        status = 1;
     }
     catch (MemoryLimitExceeded& e) {
         std::cerr << "Memory Limit Exceeded" << std::endl;
-        return 1;
+        status = 1;
     }
     catch (TimeLimitExceeded& e) {
         std::cerr << "Time Limit Exceeded" << std::endl;
-        return 1;
+        status = 1;
     }
     catch (FileSizeLimitExceeded& e) {
         std::remove(output.c_str());
         std::cerr << "File Size Limit Exceeded" << std::endl;
-        return 1;
+        status = 1;
+    }
+    if (profiling) {
+        profile_scope.reset();
+        std::cerr << profile.json() << std::endl;
     }
-    return 0;
+    return status;
 }
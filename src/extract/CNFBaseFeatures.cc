@@ -10,6 +10,33 @@
 #include "src/util/StreamBuffer.h"
 #include "src/util/CaptureDistribution.h"
 #include "src/util/UnionFind.h"
+#include "src/util/ResourceBudget.h"
+#include "src/util/Timer.h"
+
+namespace {
+// clause reader over a loaded formula, same interface as StreamBuffer::readClause()
+class FormulaReader {
+    const CNFFormula& formula_;
+    size_t pos_ = 0;
+
+  public:
+    explicit FormulaReader(const CNFFormula& formula) : formula_(formula) { }
+
+    bool readClause(Cl& out) {
+        if (pos_ >= formula_.nClauses()) return false;
+        out = *formula_[pos_++];
+        return true;
+    }
+};
+}  // namespace
+
+CNF::BaseFeatures1::BaseFeatures1(const CNFFormula& formula) : BaseFeatures1("") {
+    formula_ = &formula;
+}
+
+CNF::BaseFeatures1::BaseFeatures1(const RawClauses& clauses) : BaseFeatures1("") {
+    raw_ = &clauses;
+}
 
 CNF::BaseFeatures1::BaseFeatures1(const char* filename) : filename_(filename), features(), names() { 
     clause_sizes.fill(0);
@@ -25,10 +52,25 @@ CNF::BaseFeatures1::BaseFeatures1(const char* filename) : filename_(filename), f
 CNF::BaseFeatures1::~BaseFeatures1() { }
 
 void CNF::BaseFeatures1::extract() {
-    StreamBuffer in(filename_);
+    if (formula_ != nullptr) {
+        FormulaReader in(*formula_);
+        extract(in);
+    } else if (raw_ != nullptr) {
+        RawClauses::Reader in(*raw_);
+        extract(in);
+    } else {
+        StreamBuffer in(filename_);
+        extract(in);
+    }
+}
+
+template <typename Reader>
+void CNF::BaseFeatures1::extract(Reader& in) {
+    PhaseTimer::Measure parse(PhaseTimer::PARSE);
     UnionFind uf;
     Cl clause;
     while (in.readClause(clause)) {
+        ResourceBudget::checkpoint();
         ++n_clauses;            
         ++clause_sizes[std::min(clause.size(), 10UL)];
         bytes += 2;
@@ -70,6 +112,7 @@ void CNF::BaseFeatures1::extract() {
             balance_clause.push_back((double)std::min(n_pos, n_neg) / (double)std::max(n_pos, n_neg));
         }
     }
+    PhaseTimer::Measure statistics(PhaseTimer::STATISTICS);
     // balance of positive and negative literals per variable
     for (unsigned v = 0; v < n_vars; v++) {
         double pos = (double)literal_occurrences[Lit(v, false)];
@@ -103,6 +146,14 @@ std::vector<std::string> CNF::BaseFeatures1::getNames() const {
     return names;
 }
 
+CNF::BaseFeatures2::BaseFeatures2(const CNFFormula& formula) : BaseFeatures2("") {
+    formula_ = &formula;
+}
+
+CNF::BaseFeatures2::BaseFeatures2(const RawClauses& clauses) : BaseFeatures2("") {
+    raw_ = &clauses;
+}
+
 CNF::BaseFeatures2::BaseFeatures2(const char* filename) : filename_(filename), features(), names() { 
     names.insert(names.end(), { "vcg_vdegree_mean", "vcg_vdegree_variance", "vcg_vdegree_min", "vcg_vdegree_max", "vcg_vdegree_entropy" });
     names.insert(names.end(), { "vcg_cdegree_mean", "vcg_cdegree_variance", "vcg_cdegree_min", "vcg_cdegree_max", "vcg_cdegree_entropy" });
@@ -113,10 +164,24 @@ CNF::BaseFeatures2::BaseFeatures2(const char* filename) : filename_(filename), f
 CNF::BaseFeatures2::~BaseFeatures2() { }
 
 void CNF::BaseFeatures2::extract() {
-    StreamBuffer in(filename_);
+    if (formula_ != nullptr) {
+        FormulaReader in(*formula_), in2(*formula_);
+        extract(in, in2);
+    } else if (raw_ != nullptr) {
+        RawClauses::Reader in(*raw_), in2(*raw_);
+        extract(in, in2);
+    } else {
+        StreamBuffer in(filename_), in2(filename_);
+        extract(in, in2);
+    }
+}
 
+template <typename Reader>
+void CNF::BaseFeatures2::extract(Reader& in, Reader& in2) {
+    PhaseTimer::Measure parse(PhaseTimer::PARSE);
     Cl clause;
     while (in.readClause(clause)) {
+        ResourceBudget::checkpoint();
         vcg_cdegree.push_back(clause.size());
 
         for (Lit lit : clause) {
@@ -132,8 +197,8 @@ void CNF::BaseFeatures2::extract() {
         }
     }
     // clause graph features
-    StreamBuffer in2(filename_);
     while (in2.readClause(clause)) {
+        ResourceBudget::checkpoint();
         unsigned degree = 0;
         for (Lit lit : clause) {
             degree += vcg_vdegree[lit.var()];
@@ -141,6 +206,7 @@ void CNF::BaseFeatures2::extract() {
         clause_degree.push_back(degree);
     }
 
+    PhaseTimer::Measure statistics(PhaseTimer::STATISTICS);
     load_feature_records();
 }
 
@@ -159,6 +225,14 @@ std::vector<std::string> CNF::BaseFeatures2::getNames() const {
     return names;
 }
 
+CNF::BaseFeatures::BaseFeatures(const CNFFormula& formula) : BaseFeatures("") {
+    formula_ = &formula;
+}
+
+CNF::BaseFeatures::BaseFeatures(const RawClauses& clauses) : BaseFeatures("") {
+    raw_ = &clauses;
+}
+
 CNF::BaseFeatures::BaseFeatures(const char* filename) : filename_(filename), features(), names() { 
     BaseFeatures1 baseFeatures1(filename_);
     auto names1 = baseFeatures1.getNames();
@@ -176,14 +250,14 @@ void CNF::BaseFeatures::extract() {
 }
 
 void CNF::BaseFeatures::extractBaseFeatures1() {
-    BaseFeatures1 baseFeatures1(filename_);
+    BaseFeatures1 baseFeatures1 = formula_ ? BaseFeatures1(*formula_) : raw_ ? BaseFeatures1(*raw_) : BaseFeatures1(filename_);
     baseFeatures1.extract();
     auto feat = baseFeatures1.getFeatures();
     features.insert(features.end(), feat.begin(), feat.end());
 }
 
 void CNF::BaseFeatures::extractBaseFeatures2() {
-    BaseFeatures2 baseFeatures2(filename_);
+    BaseFeatures2 baseFeatures2 = formula_ ? BaseFeatures2(*formula_) : raw_ ? BaseFeatures2(*raw_) : BaseFeatures2(filename_);
     baseFeatures2.extract();
     auto feat = baseFeatures2.getFeatures();
     features.insert(features.end(), feat.begin(), feat.end());
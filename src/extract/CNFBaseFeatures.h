@@ -8,10 +8,20 @@
 #include "IExtractor.h"
 #include <array>
 
+#include "src/util/CNFFormula.h"
+#include "src/util/RawClauses.h"
+
 namespace CNF {
 
+/**
+ * The base feature extractors either stream the clauses of the given file,
+ * read them from an already loaded (and thus sanitized) formula,
+ * or from the raw clauses of a file, which give the same features as the file.
+ */
 class BaseFeatures : public IExtractor {
     const char* filename_;
+    const CNFFormula* formula_ = nullptr;
+    const RawClauses* raw_ = nullptr;
     std::vector<double> features;
     std::vector<std::string> names;
 
@@ -20,6 +30,8 @@ class BaseFeatures : public IExtractor {
 
   public:
     BaseFeatures(const char* filename);
+    explicit BaseFeatures(const CNFFormula& formula);
+    explicit BaseFeatures(const RawClauses& clauses);
     virtual ~BaseFeatures();
     virtual void extract();
     virtual std::vector<double> getFeatures() const;
@@ -28,6 +40,8 @@ class BaseFeatures : public IExtractor {
 
 class BaseFeatures1 : public IExtractor {
     const char* filename_;
+    const CNFFormula* formula_ = nullptr;
+    const RawClauses* raw_ = nullptr;
     std::vector<double> features;
     std::vector<std::string> names;
     unsigned n_vars = 0, n_clauses = 0, bytes = 0, ccs = 0;
@@ -38,18 +52,22 @@ class BaseFeatures1 : public IExtractor {
     // number of positive and negative clauses
     unsigned positive = 0, negative = 0;
     // occurrence counts in horn clauses (per variable)
-    std::vector<unsigned> variable_horn, variable_inv_horn;
+    BudgetVector<unsigned> variable_horn, variable_inv_horn;
     // pos-neg literal balance (per clause)
-    std::vector<double> balance_clause;
+    BudgetVector<double> balance_clause;
     // pos-neg literal balance (per variable)
-    std::vector<double> balance_variable;
+    BudgetVector<double> balance_variable;
     // Literal Occurrences
-    std::vector<unsigned> literal_occurrences;
+    BudgetVector<unsigned> literal_occurrences;
 
+    template <typename Reader>
+    void extract(Reader& in);
     void load_feature_record();
 
   public:
     BaseFeatures1(const char* filename);
+    explicit BaseFeatures1(const CNFFormula& formula);
+    explicit BaseFeatures1(const RawClauses& clauses);
     virtual ~BaseFeatures1();
     virtual void extract();
     virtual std::vector<double> getFeatures() const;
@@ -58,21 +76,27 @@ class BaseFeatures1 : public IExtractor {
 
 class BaseFeatures2 : public IExtractor {
     const char* filename_;
+    const CNFFormula* formula_ = nullptr;
+    const RawClauses* raw_ = nullptr;
     std::vector<double> features;
     std::vector<std::string> names;
     unsigned n_vars = 0, n_clauses = 0;
     // VCG Degree Distribution:
-    std::vector<unsigned> vcg_cdegree; // clause sizes
-    std::vector<unsigned> vcg_vdegree; // occurence counts
+    BudgetVector<unsigned> vcg_cdegree; // clause sizes
+    BudgetVector<unsigned> vcg_vdegree; // occurence counts
     // VIG Degree Distribution:
-    std::vector<unsigned> vg_degree;
+    BudgetVector<unsigned> vg_degree;
     // CG Degree Distribution:
-    std::vector<unsigned> clause_degree;
+    BudgetVector<unsigned> clause_degree;
 
+    template <typename Reader>
+    void extract(Reader& in, Reader& in2);
     void load_feature_records();
 
   public:
     BaseFeatures2(const char* filename);
+    explicit BaseFeatures2(const CNFFormula& formula);
+    explicit BaseFeatures2(const RawClauses& clauses);
     virtual ~BaseFeatures2();
     virtual void extract();
     virtual std::vector<double> getFeatures() const;
@@ -9,8 +9,14 @@
 #include "src/extract/gates/GateFormula.h"
 #include "src/extract/gates/GateAnalyzer.h"
 #include "src/util/CaptureDistribution.h"
+#include "src/util/Timer.h"
 
-CNF::GateFeatures::GateFeatures(const char* filename) : filename_(filename), features(), names() { 
+CNF::GateFeatures::GateFeatures(const CNFFormula& formula, double check_limit, const OccurrenceIndex* occurrences) : GateFeatures("", check_limit) {
+    formula_ = &formula;
+    occurrences_ = occurrences;
+}
+
+CNF::GateFeatures::GateFeatures(const char* filename, double check_limit, bool rename) : filename_(filename), check_limit_(check_limit), rename_(rename), features(), names() { 
     names.insert(names.end(), { "n_vars", "n_gates", "n_roots" });
     names.insert(names.end(), { "n_none", "n_generic", "n_mono" });
     names.insert(names.end(), { "n_and", "n_or", "n_triv", "n_equiv", "n_full" });
@@ -23,70 +29,96 @@ CNF::GateFeatures::GateFeatures(const char* filename) : filename_(filename), fea
     names.insert(names.end(), { "levels_triv_mean", "levels_triv_variance", "levels_triv_min", "levels_triv_max", "levels_triv_entropy" });
     names.insert(names.end(), { "levels_equiv_mean", "levels_equiv_variance", "levels_equiv_min", "levels_equiv_max", "levels_equiv_entropy" });
     names.insert(names.end(), { "levels_full_mean", "levels_full_variance", "levels_full_min", "levels_full_max", "levels_full_entropy" });
+    names.insert(names.end(), { "n_aborted", "partial" });
+    names.insert(names.end(), { "n_duplicates" });
 }
 
 CNF::GateFeatures::~GateFeatures() { }
 
 void CNF::GateFeatures::extract() {
-    CNFFormula formula(filename_);
-    GateAnalyzer analyzer(formula, true, true, formula.nVars() / 3, false);
-    analyzer.analyze();
-    GateFormula gates = analyzer.getGateFormula();
+    if (formula_ != nullptr) {
+        extract(*formula_);
+    } else {
+        // duplicate clauses break the 2^n clause pattern of full gates
+        CNFFormula formula;
+        formula.enableDeduplication();
+        // sparse variable ids would otherwise size all tables of the analysis by the largest id
+        if (rename_) formula.enableRenaming();
+        formula.readDimacsFromFile(filename_);
+        extract(formula);
+    }
+}
+
+void CNF::GateFeatures::extract(const CNFFormula& formula) {
+    n_duplicates = formula.nDuplicates();
+    PhaseTimer::Measure analyze(PhaseTimer::ANALYZE);
+    GateAnalyzer<> analyzer(formula, true, true, formula.nVars() / 3, false, 1, check_limit_, occurrences_);
+    analyzer.analyze(true);  // features of the partial gate formula if the budget expires
+    const GateFormula& gates = analyzer.getGateFormula();
+    n_aborted = analyzer.nAborted();
+    partial = analyzer.isPartial();
+    PhaseTimer::Measure statistics(PhaseTimer::STATISTICS);
     n_vars = formula.nVars();
     n_gates = gates.nGates();
     n_roots = gates.nRoots();
-    levels.resize(n_vars + 1, 0);
-    // BFS for level determination
-    unsigned level = 0;
-    std::vector<Lit> current = gates.getRoots();
-    std::vector<Lit> next;
-    while (!current.empty()) {
-        ++level;
+    // BFS for level determination, variables are leveled when they are pushed such that each gate is visited once
+    std::vector<unsigned> level(n_vars + 1, 0);
+    std::vector<Lit> current, next;
+    for (Lit lit : gates.getRoots()) {
+        if (gates.getGate(lit).isDefined() && level[lit.var()] == 0) {
+            level[lit.var()] = 1;
+            current.push_back(lit);
+        }
+    }
+    for (unsigned depth = 1; !current.empty(); ++depth) {
         for (Lit lit : current) {
-            const Gate& gate = gates.getGate(lit);
-            if (gate.isDefined() && levels[lit.var()] == 0) {
-                levels[lit.var()] = level;
-                next.insert(next.end(), gate.inp.begin(), gate.inp.end());
+            for (Lit input : gates.inp(gates.getGate(lit))) {
+                if (gates.getGate(input).isDefined() && level[input.var()] == 0) {
+                    level[input.var()] = depth + 1;
+                    next.push_back(input);
+                }
             }
         }
         current.clear();
         current.swap(next);
     }
     // Gate Type Counts and Levels
+    add_to_histogram(levels, 0);  // variable 0 (historically part of the levels distribution)
     for (unsigned i = 1; i <= n_vars; i++) {
         const Gate& gate = gates.getGate(Lit(Var(i)));
+        add_to_histogram(levels, level[i]);
         switch (gate.type) {
             case NONE:  // input variable
                 ++n_none;
-                levels_none.push_back(levels[i]);
+                add_to_histogram(levels_none, level[i]);
                 break;
             case GENERIC:  // generically recognized gate
                 ++n_generic;
-                levels_generic.push_back(levels[i]);
+                add_to_histogram(levels_generic, level[i]);
                 break;
             case MONO:  // monotonically nested gate
                 ++n_mono;
-                levels_mono.push_back(levels[i]);
+                add_to_histogram(levels_mono, level[i]);
                 break;
             case AND:  // non-monotonically nested and-gate
                 ++n_and;
-                levels_and.push_back(levels[i]);
+                add_to_histogram(levels_and, level[i]);
                 break;
             case OR:  // non-monotonically nested or-gate
                 ++n_or;
-                levels_or.push_back(levels[i]);
+                add_to_histogram(levels_or, level[i]);
                 break;
             case TRIV:  // non-monotonically nested trivial equivalence gate
                 ++n_triv;
-                levels_triv.push_back(levels[i]);
+                add_to_histogram(levels_triv, level[i]);
                 break;
             case EQIV:  // non-monotonically nested equiv- or xor-gate
                 ++n_equiv;
-                levels_equiv.push_back(levels[i]);
+                add_to_histogram(levels_equiv, level[i]);
                 break;
             case FULL:  // non-monotonically nested full gate (=maxterm encoding) with more than two inputs
                 ++n_full;
-                levels_full.push_back(levels[i]);
+                add_to_histogram(levels_full, level[i]);
                 break;
         }
     }
@@ -97,15 +129,17 @@ void CNF::GateFeatures::load_feature_records() {
     features.insert(features.end(), { (double)n_vars, (double)n_gates, (double)n_roots});
     features.insert(features.end(), { (double)n_none, (double)n_generic, (double)n_mono});
     features.insert(features.end(), { (double)n_and, (double)n_or, (double)n_triv, (double)n_equiv, (double)n_full});
-    push_distribution(features, levels);
-    push_distribution(features, levels_none);
-    push_distribution(features, levels_generic);
-    push_distribution(features, levels_mono);
-    push_distribution(features, levels_and);
-    push_distribution(features, levels_or);
-    push_distribution(features, levels_triv);
-    push_distribution(features, levels_equiv);
-    push_distribution(features, levels_full);
+    push_histogram(features, levels);
+    push_histogram(features, levels_none);
+    push_histogram(features, levels_generic);
+    push_histogram(features, levels_mono);
+    push_histogram(features, levels_and);
+    push_histogram(features, levels_or);
+    push_histogram(features, levels_triv);
+    push_histogram(features, levels_equiv);
+    push_histogram(features, levels_full);
+    features.insert(features.end(), { (double)n_aborted, (double)partial });
+    features.insert(features.end(), { (double)n_duplicates });
 }
 
 std::vector<double> CNF::GateFeatures::getFeatures() const {
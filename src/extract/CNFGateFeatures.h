@@ -6,6 +6,7 @@
 #pragma once
 
 #include <math.h>
+#include <cstdint>
 #include <vector>
 #include <iostream>
 #include <algorithm>
@@ -13,26 +14,38 @@
 #include <string>
 
 #include "src/extract/IExtractor.h"
+#include "src/util/CNFFormula.h"
+#include "src/util/OccurrenceIndex.h"
 
 namespace CNF {
 
 class GateFeatures : public IExtractor {
     const char *filename_;
+    const CNFFormula* formula_ = nullptr;
+    const OccurrenceIndex* occurrences_ = nullptr;  // shared occurrence index of formula_
+    double check_limit_;  // time limit of a single semantic gate check in seconds (0 = unlimited)
+    bool rename_;  // rename variables to 1..n in order of first occurrence while reading the file
     std::vector<double> features;
     std::vector<std::string> names;
 
     unsigned n_vars = 0, n_gates = 0, n_roots = 0;
     unsigned n_none = 0, n_generic = 0, n_mono = 0;
     unsigned n_and = 0, n_or = 0, n_triv = 0, n_equiv = 0, n_full = 0;
+    unsigned n_aborted = 0;
+    bool partial = false;  // gate analysis stopped at the deadline
+    unsigned n_duplicates = 0;
 
-    std::vector<unsigned> levels, levels_none, levels_generic, levels_mono;
-    std::vector<unsigned> levels_and, levels_or, levels_triv;
-    std::vector<unsigned> levels_equiv, levels_full;
+    // histograms of levels (number of variables per level) in total and per gate type
+    std::vector<uint64_t> levels, levels_none, levels_generic, levels_mono;
+    std::vector<uint64_t> levels_and, levels_or, levels_triv;
+    std::vector<uint64_t> levels_equiv, levels_full;
 
+    void extract(const CNFFormula& formula);
     void load_feature_records();
 
 public:
-    GateFeatures(const char* filename);
+    GateFeatures(const char* filename, double check_limit = 0, bool rename = false);
+    explicit GateFeatures(const CNFFormula& formula, double check_limit = 0, const OccurrenceIndex* occurrences = nullptr);
     virtual ~GateFeatures();
     virtual void extract();
     virtual std::vector<double> getFeatures() const;
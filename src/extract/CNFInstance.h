@@ -0,0 +1,74 @@
+/**
+ * MIT License
+ * Copyright (c) 2024 Markus Iser
+ */
+
+#pragma once
+
+#include <memory>
+#include <mutex>
+#include <string>
+
+#include "src/extract/CNFBaseFeatures.h"
+#include "src/extract/CNFGateFeatures.h"
+#include "src/identify/ISOHash.h"
+#include "src/util/CNFFormula.h"
+#include "src/util/OccurrenceIndex.h"
+#include "src/util/RawClauses.h"
+
+namespace CNF {
+
+/**
+ * @brief CNF instance which is parsed once and shared by extractors and transformers
+ * The file is read once into its raw clauses, from which the sanitized formula is built, i.e.,
+ * free of tautologies, duplicate literals and duplicate clauses. Base features and isohash identify the file
+ * and are computed from the raw clauses, such that they equal the values of BaseFeatures(filename) and isohash(filename).
+ * With rename, the variables of the formula are renamed to 1..n in order of first occurrence (see CNFFormula::enableRenaming()).
+ * The occurrence index of the formula is built on first use and shared by all gate analyses of the instance.
+ */
+class Instance {
+    std::string filename_;
+    RawClauses raw_;
+    CNFFormula formula_;
+    mutable std::once_flag indexed_;
+    mutable std::unique_ptr<const OccurrenceIndex> occurrences_;
+
+ public:
+    explicit Instance(const std::string& filename, bool rename = false) : filename_(filename), raw_(filename_.c_str()), formula_() {
+        formula_.enableDeduplication();
+        if (rename) formula_.enableRenaming();
+        for (size_t i = 0; i < raw_.nClauses(); ++i) {
+            Span<const Lit> clause = raw_[i];
+            formula_.readClause(clause.begin(), clause.end());
+        }
+    }
+
+    const std::string& filename() const {
+        return filename_;
+    }
+
+    // sanitized formula
+    const CNFFormula& formula() const {
+        return formula_;
+    }
+
+    std::unique_ptr<IExtractor> baseFeatures() const {
+        return std::unique_ptr<IExtractor>(new BaseFeatures(raw_));
+    }
+
+    // occurrence index of the non-unit clauses of the formula
+    const OccurrenceIndex& occurrences() const {
+        std::call_once(indexed_, [this] { occurrences_.reset(new OccurrenceIndex(formula_, true)); });
+        return *occurrences_;
+    }
+
+    std::unique_ptr<IExtractor> gateFeatures(double check_limit = 0) const {
+        return std::unique_ptr<IExtractor>(new GateFeatures(formula_, check_limit, &occurrences()));
+    }
+
+    std::string isohash() const {
+        return CNF::isohash(raw_);
+    }
+};
+
+}  // namespace CNF
@@ -10,13 +10,22 @@
 #include <string>
 #include <vector>
 
+#include "src/util/ResourceBudget.h"
+
 class IExtractor {
 public:
     virtual ~IExtractor() { }
     virtual void extract() = 0;
+
+    // extract() on the current thread within the given time and memory budget
+    void extractWithin(ResourceBudget& budget) {
+        ResourceBudget::Scope scope(budget);
+        extract();
+    }
+
     virtual std::vector<double> getFeatures() const = 0;
     virtual std::vector<std::string> getNames() const = 0;
-    virtual std::string getRuntimeDesc() {return "base_features_runtime";};
+    virtual std::string getRuntimeDesc() const {return "base_features_runtime";};
 };
 
 #endif // EXTRACTOR_INTERFACE_H_
\ No newline at end of file
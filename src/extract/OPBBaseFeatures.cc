@@ -7,6 +7,8 @@
 
 #include "src/util/StreamBuffer.h"
 #include "src/util/CaptureDistribution.h"
+#include "src/util/ResourceBudget.h"
+#include "src/util/Timer.h"
 
 OPB::TermSum::TermSum(StreamBuffer &in) {
     for (in.skipWhitespace(); *in != ';' && *in != '>' && *in != '='; in.skipWhitespace()) {
@@ -115,10 +117,12 @@ OPB::BaseFeatures::BaseFeatures(const char* filename) : filename_(filename), fea
 OPB::BaseFeatures::~BaseFeatures() { }
 
 void OPB::BaseFeatures::extract() {
+    PhaseTimer::Measure parse(PhaseTimer::PARSE);
     StreamBuffer in(filename_);
 
     bool seen_obj = false;
     while (in.skipWhitespace()) {
+        ResourceBudget::checkpoint();
         if (*in == '*') {
             in.skipLine();
         } else if (*in == 'm') {
@@ -171,6 +175,7 @@ void OPB::BaseFeatures::extract() {
         }
     }
     
+    PhaseTimer::Measure statistics(PhaseTimer::STATISTICS);
     load_feature_record();
 }
 
@@ -18,7 +18,7 @@ class TermSum {
     friend Constr;
     friend BaseFeatures;
 
-    std::vector<double> coeffs{};
+    BudgetVector<double> coeffs{};
     double max = 0;
     double min = 0;
     double abs_min_coeff = std::numeric_limits<double>::max();
@@ -72,7 +72,7 @@ class BaseFeatures : public IExtractor {
     
     unsigned obj_terms = 0;
     double obj_max_val = 0, obj_min_val = 0;
-    std::vector<double> obj_coeffs{};
+    BudgetVector<double> obj_coeffs{};
 
     void load_feature_record();
 
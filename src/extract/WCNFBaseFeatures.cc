@@ -8,6 +8,9 @@
 #include <cassert>
 #include <algorithm>
 
+#include "src/util/ResourceBudget.h"
+#include "src/util/Timer.h"
+
 WCNF::BaseFeatures1::BaseFeatures1(const char* filename) : filename_(filename), features(), names() { 
     hard_clause_sizes.fill(0);
     soft_clause_sizes.fill(0);
@@ -26,12 +29,14 @@ WCNF::BaseFeatures1::BaseFeatures1(const char* filename) : filename_(filename),
 WCNF::BaseFeatures1::~BaseFeatures1() { }
 
 void WCNF::BaseFeatures1::extract() {
+    PhaseTimer::Measure parse(PhaseTimer::PARSE);
     StreamBuffer in(filename_);
 
     Cl clause;
     uint64_t top = 0; // if top is 0, parsing new file format
     uint64_t weight = 0; // if weight is 0, parsing hard clause
     while (in.skipWhitespace()) {
+        ResourceBudget::checkpoint();
         if (*in == 'c') {
             if (!in.skipLine()) break;
             continue;
@@ -124,6 +129,7 @@ void WCNF::BaseFeatures1::extract() {
         }
     }
 
+    PhaseTimer::Measure statistics(PhaseTimer::STATISTICS);
     // balance of positive and negative literals per variable
     for (unsigned v = 0; v < n_vars; v++) {
         double pos = (double)literal_occurrences[Lit(v, false)];
@@ -171,12 +177,14 @@ WCNF::BaseFeatures2::BaseFeatures2(const char* filename) : filename_(filename),
 WCNF::BaseFeatures2::~BaseFeatures2() { }
 
 void WCNF::BaseFeatures2::extract() {
+    PhaseTimer::Measure parse(PhaseTimer::PARSE);
     StreamBuffer in(filename_);
 
     Cl clause;
     uint64_t top = 0; // if top is 0, parsing new file format
     uint64_t weight;
     while (in.skipWhitespace()) {
+        ResourceBudget::checkpoint();
         if (*in == 'c') {
             if (!in.skipLine()) break;
             continue;
@@ -225,6 +233,7 @@ void WCNF::BaseFeatures2::extract() {
     // clause graph features
     StreamBuffer in2(filename_);
     while (in2.skipWhitespace()) {
+        ResourceBudget::checkpoint();
         if (*in2 == 'c' || *in2 == 'p') {
             if (!in2.skipLine()) break;
             continue;
@@ -246,6 +255,7 @@ void WCNF::BaseFeatures2::extract() {
         clause_degree.push_back(degree);
     }
 
+    PhaseTimer::Measure statistics(PhaseTimer::STATISTICS);
     load_feature_records();
 }
 
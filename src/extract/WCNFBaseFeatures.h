@@ -27,15 +27,15 @@ class BaseFeatures1 : public IExtractor {
     // number of positive and negative clauses
     unsigned positive = 0, negative = 0;
     // occurrence counts in horn clauses (per variable)
-    std::vector<unsigned> variable_horn, variable_inv_horn;
+    BudgetVector<unsigned> variable_horn, variable_inv_horn;
     // pos-neg literal balance (per clause)
-    std::vector<double> balance_clause;
+    BudgetVector<double> balance_clause;
     // pos-neg literal balance (per variable)
-    std::vector<double> balance_variable;
+    BudgetVector<double> balance_variable;
     // Literal Occurrences
-    std::vector<unsigned> literal_occurrences;    
+    BudgetVector<unsigned> literal_occurrences;    
     // Soft clause weights
-    std::vector<uint64_t> weights;
+    BudgetVector<uint64_t> weights;
 
     void load_feature_record();
 
@@ -53,12 +53,12 @@ class BaseFeatures2 : public IExtractor {
     std::vector<std::string> names;
     unsigned n_vars = 0;
     // VCG Degree Distribution
-    std::vector<unsigned> vcg_cdegree; // clause sizes
-    std::vector<unsigned> vcg_vdegree; // occurence counts
+    BudgetVector<unsigned> vcg_cdegree; // clause sizes
+    BudgetVector<unsigned> vcg_vdegree; // occurence counts
     // VIG Degree Distribution
-    std::vector<unsigned> vg_degree;
+    BudgetVector<unsigned> vg_degree;
     // CG Degree Distribution
-    std::vector<unsigned> clause_degree;
+    BudgetVector<unsigned> clause_degree;
 
     void load_feature_records();
 
@@ -21,19 +21,34 @@ OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWA
 #define SRC_GATES_BLOCKLIST_H_
 
 
+#include <cstdint>
 #include <vector>
 #include <set>
 #include <limits>
 #include <utility>
+#include <algorithm>
 
 #include "src/util/CNFFormula.h"
-
+#include "src/util/OccurrenceIndex.h"
+#include "src/util/Profile.h"
+#include "src/util/ResourceBudget.h"
+
+/**
+ * @brief Occurrence lists with incremental blocked-clause counters, alternative index backend of GateAnalyzer
+ * The blocked clauses of literal l (w.r.t. all clauses of ~l) are kept at the front of its list: index[l][0, num_blocked[l]),
+ * counters are computed on demand and invalidated if removals might change them, blocked-set queries are O(1) amortized.
+ * Root selection picks the literal with the fewest unblocked clauses.
+ */
 class BlockList {
     const CNFFormula& problem;
 
-    std::vector<For> index;
+    static constexpr uint32_t unknown = std::numeric_limits<uint32_t>::max();
+
+    // occurrences of literals in non-unit clauses, the remaining occurrences of literal l
+    // are kept at the front of its list: index[l][0, index.length(l))
+    OccurrenceLists index;
     std::vector<Cl*> unitc;
-    std::vector<uint16_t> num_blocked;
+    std::vector<uint32_t> num_blocked;  // unknown if not (yet) computed
 
     #define CLAUSES_ARE_SORTED
 #ifdef CLAUSES_ARE_SORTED
@@ -51,81 +66,89 @@ class BlockList {
 #endif
 
     bool isBlocked(Lit o, Cl* clause) const {  // assert o \in clause
-        for (Cl* c2 : index[~o]) if (!isBlocked(o, *clause, *c2)) return false;
+        for (Cl* c2 : (*this)[~o]) if (!isBlocked(o, *clause, *c2)) return false;
         return true;
     }
 
+    inline unsigned size(Lit lit) const {
+        return index.length(lit);
+    }
+
+    // remove clause from occurrences of lit preserving order, return former position or size(lit) if not found
+    unsigned erase(Lit lit, Cl* clause) {
+        ClauseSpan occ = index[lit];
+        Cl* const* found = std::find(occ.begin(), occ.end(), clause);
+        unsigned pos = found - occ.begin();
+        if (pos < occ.size()) {
+            Span<Cl*> list = index.modify(lit);
+            std::copy(list.begin() + pos + 1, list.end(), list.begin() + pos);
+            index.truncate(lit, list.size() - 1);
+        }
+        return pos;
+    }
+
     void initBlockingCounter(Lit o) {
+        Span<Cl*> occ = index.modify(o);
         int i = 0;
-        int j = index[o].size()-1;
+        int j = occ.size()-1;
         while (i <= j) {
-            // ::cout << i << " <= " << j << " < " << index[o].size() << std::endl;
-            if (isBlocked(o, index[o][i])) {
+            // ::cout << i << " <= " << j << " < " << occ.size() << std::endl;
+            if (isBlocked(o, occ[i])) {
                 ++i;
             } else {
-                if (i < j) std::swap(index[o][i], index[o][j]);
+                if (i < j) std::swap(occ[i], occ[j]);
                 --j;
             }
         }
         num_blocked[o] = i;
-        if (num_blocked[o] == index[o].size()) {
-            num_blocked[~o] = index[~o].size();
+        if (num_blocked[o] == size(o)) {
+            num_blocked[~o] = size(~o);
         }
     }
 
+    inline uint32_t blocked(Lit o) {
+        if (num_blocked[o] == unknown) initBlockingCounter(o);
+        return num_blocked[o];
+    }
+
+    // removals from index[~o] can only turn unblocked clauses of o into blocked ones
+    inline void invalidate(Lit o) {
+        if (num_blocked[o] != size(o)) num_blocked[o] = unknown;
+    }
+
  public:
-    explicit BlockList(const CNFFormula& problem_) : problem(problem_), unitc() {
-        index.resize(2 + 2 * problem.nVars());
-        num_blocked.resize(2 + 2 * problem.nVars(), 0);
+    /**
+     * @param occurrences occurrence index of the non-unit clauses shared with other consumers, or nullptr to build an own index
+     */
+    explicit BlockList(const CNFFormula& problem_, const OccurrenceIndex* occurrences = nullptr) : problem(problem_), index(problem_, occurrences), unitc() {
+        num_blocked.resize(2 + 2 * problem.nVars(), unknown);
 
         for (Cl* clause : problem_) {
             if (clause->size() == 1) {
                 unitc.push_back(clause);
-            } else {
-                for (Lit lit : *clause) {
-                    index[lit].push_back(clause);
-                }
             }
         }
     }
 
     ~BlockList() { }
 
-    void remove(Var o) {
-        std::set<Lit> literals;
-        for (Lit olit : { Lit(o, false), Lit(o, true) }) {
-            for (Cl* clause : index[olit]) {
-                for (Lit lit : *clause) {
-                    if (lit != olit) {
-                        unsigned pos = 0;
-                        for (auto it = index[lit].begin(); it < index[lit].end(); it++, pos++) {
-                            if (*it == clause) {
-                                index[lit].erase(it);
-                                break;
-                            }
-                        }
-                        if (pos < num_blocked[lit]) {  // removed clause was blocked by lit
-                            --num_blocked[lit];
-                            if (num_blocked[lit] == index[lit].size()) {
-                                num_blocked[~lit] = index[~lit].size();
-                            }
-                        } else if (num_blocked[lit] == index[lit].size()) {
-                            num_blocked[~lit] = index[~lit].size();
-                        } else {
-                            literals.insert(~lit);
-                        }
-                    }
-                }
+    void remove(ClauseSpan list) {
+        for (Cl* clause : list) for (Lit lit : *clause) {
+            unsigned length = size(lit);
+            unsigned pos = erase(lit, clause);
+            if (pos == length) continue;  // not indexed (unit) or already removed
+            if (num_blocked[lit] != unknown && pos < num_blocked[lit]) {
+                --num_blocked[lit];  // removed clause was blocked, i.e., it did not constrain the clauses of ~lit
+            } else {
+                invalidate(~lit);
+            }
+            if (num_blocked[lit] == size(lit)) {
+                num_blocked[~lit] = size(~lit);
             }
-            index[olit].clear();
-            num_blocked[olit] = 0;
-        }
-        for (Lit lit : literals) {
-            if (num_blocked[lit] != index[lit].size()) initBlockingCounter(lit);
         }
     }
 
-    inline const For& operator[] (size_t o) const {
+    inline ClauseSpan operator[] (size_t o) const {
         return index[o];
     }
 
@@ -134,7 +157,8 @@ class BlockList {
     }
 
     inline bool isBlockedSet(Lit o) {
-        return index[o].size() == num_blocked[o];
+        GBDC_PROFILE_COUNT(BLOCKED_SET_CHECKS, 1);
+        return size(o) == blocked(o);
     }
 
     For estimateRoots() {
@@ -149,23 +173,18 @@ class BlockList {
             }
         }
 
-        for (Cl* c : result) for (Lit l : *c) if (num_blocked[l] == 0) initBlockingCounter(l);
-
         return result;
     }
 
     Lit getMinimallyUnblockedLiteral() {
         Lit result = lit_Undef;
-        uint16_t min = std::numeric_limits<uint16_t>::max();
-        for (int v = problem.nVars()-1; v >= 0 && min > 1; v--) {
+        uint32_t min = unknown;
+        for (unsigned v = problem.nVars(); v > 0 && min > 1; v--) {
+            ResourceBudget::checkpoint();
             for (Lit lit : { Lit(v, true), Lit(v, false) }) {
-                size_t total = index[lit].size();
-                if (num_blocked[lit] == 0) {
-                    initBlockingCounter(lit);
-                }
-                size_t diff = total - num_blocked[lit];
+                uint32_t diff = size(lit) - blocked(lit);
                 if (diff > 0 && diff < min) {
-                    min = (uint16_t)diff;
+                    min = diff;
                     result = lit;
                 }
             }
@@ -183,16 +202,15 @@ class BlockList {
 
         for (Cl* clause : result) {
             for (Lit lit : *clause) {
-                For& h = index[lit];
-                h.erase(std::remove(h.begin(), h.end(), clause), h.end());
+                erase(lit, clause);
                 if (lit != o) {
-                    num_blocked[lit] = 0;
-                    num_blocked[~lit] = 0;
-                } else {
-                    num_blocked[~lit] = index[~lit].size();
+                    num_blocked[lit] = unknown;
+                    invalidate(~lit);
                 }
             }
         }
+        num_blocked[o] = size(o);  // remaining clauses are blocked
+        num_blocked[~o] = size(~o);
 
         return result;
     }
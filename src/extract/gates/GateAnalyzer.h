@@ -26,30 +26,63 @@ OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWA
 #include <memory>
 #include <cmath>
 #include <vector>
-#include <unordered_set>
 #include <climits>
-
-#include "src/external/ipasir.h"
+#include <utility>
 
 #include "src/util/CNFFormula.h"
+#include "src/util/ResourceBudget.h"
+#include "src/util/Profile.h"
+#include "src/util/Stamp.h"
 
 #include "src/extract/gates/GateFormula.h"
 #include "src/extract/gates/BlockList.h"
 #include "src/extract/gates/OccurrenceList.h"
-
-
+#include "src/extract/gates/SemanticFilter.h"
+#include "src/extract/gates/SolverPool.h"
+
+
+/**
+ * @tparam Index occurrence index backend: OccurrenceList (default) or BlockList,
+ * BlockList has a different root-selection heuristic (fewest unblocked clauses) and O(1) amortized blocked-set queries
+ *
+ * With more than one thread, the semantic checks of each level of the breadth-first search run speculatively
+ * in parallel at the start of the level. Their results are committed in candidate order and only if
+ * the clauses of the candidate did not change in the meantime, such that the gates are the same as in serial mode.
+ */
+template <class Index = OccurrenceList>
 class GateAnalyzer {
-    void* S;  // solver
+    std::unique_ptr<SolverPool> solvers;  // semantic checks
+    SemanticFilter filter;  // cheap tiers of semantic checks
 
     const CNFFormula& formula_;
 
     GateFormula gate_formula;
 
-    // BlockList has better root-selection heuristic but is slower in general
-    // BlockList can not be used atm as I changed the interface in favor of more hard wired code,
-    // i.e., specifically the "swap from index" in gate_formula.addGate
-    // So use OccurrenceList for now
-    OccurrenceList index;  // occurence-list
+    Index index;  // occurence-list
+
+    // reusable buffers of gate_recognition() and constrainSameInputVariables()
+    std::vector<Lit> candidates;
+    std::vector<Lit> frontier;
+    Stamp<uint32_t> in_frontier;  // literals
+    Stamp<uint32_t> fwd_vars;  // variables
+    Stamp<uint32_t> bwd_vars;
+
+    // semantic check of the current level, computed in parallel by speculate()
+    struct Speculation {
+        Lit out;
+        std::vector<Cl*> clauses;  // fwd followed by bwd at the start of the level
+        size_t n_fwd;
+        int result;  // ipasir result
+
+        bool matches(ClauseSpan fwd, ClauseSpan bwd) const {
+            return fwd.size() == n_fwd && clauses.size() == n_fwd + bwd.size()
+                && std::equal(fwd.begin(), fwd.end(), clauses.begin()) && std::equal(bwd.begin(), bwd.end(), clauses.begin() + n_fwd);
+        }
+    };
+    std::vector<Speculation> speculations;  // in candidate order
+
+    unsigned n_aborted = 0;  // semantic checks which exceeded their time limit
+    bool partial = false;  // analysis stopped at the deadline
 
     // analyzer configuration:
     bool patterns = false;
@@ -58,42 +91,77 @@ class GateAnalyzer {
     unsigned verbose_ = 0;
 
  public:
-    GateAnalyzer(const CNFFormula& formula, bool patterns_, bool semantic_, unsigned max, unsigned verbose = 0) :
-     formula_(formula), gate_formula(formula.nVars(), verbose), index(formula),
-     patterns(patterns_), semantic(semantic_), max_(max), verbose_(verbose) {
-        if (semantic) S = ipasir_init();
+    /**
+     * @param threads number of threads (and solvers) for semantic checks
+     * @param check_limit time limit of a single semantic check in seconds (0 = unlimited), candidates whose check exceeds it are no gates
+     * @param occurrences occurrence index of the non-unit clauses of formula shared by several analyzers, or nullptr (see OccurrenceLists)
+     */
+    GateAnalyzer(const CNFFormula& formula, bool patterns_, bool semantic_, unsigned max, unsigned verbose = 0, unsigned threads = 1, double check_limit = 0,
+            const OccurrenceIndex* occurrences = nullptr) :
+     solvers(), filter(formula.nVars()), formula_(formula), gate_formula(formula.nVars(), verbose), index(formula, occurrences),
+     candidates(), frontier(), in_frontier(2 + 2 * formula.nVars()), fwd_vars(1 + formula.nVars()), bwd_vars(1 + formula.nVars()),
+     speculations(), patterns(patterns_), semantic(semantic_), max_(max), verbose_(verbose) {
+        if (semantic) {
+            // interrupt semantic checks once the budget of the analyzing thread is exhausted
+            solvers.reset(new SolverPool(threads, formula.nVars(), ResourceBudget::current(), check_limit));
+        }
     }
 
-    ~GateAnalyzer() {
-        if (semantic) ipasir_release(S);
+    const GateFormula& getGateFormula() const {
+        return gate_formula;
     }
 
-    GateFormula getGateFormula() const {
-        return gate_formula;
+    // moves the gate formula out of the analyzer, which must not be used afterwards
+    GateFormula releaseGateFormula() {
+        return std::move(gate_formula);
+    }
+
+    // number of semantic checks aborted by their time limit
+    unsigned nAborted() const {
+        return n_aborted;
+    }
+
+    // true if the last anytime analysis stopped at the deadline
+    bool isPartial() const {
+        return partial;
     }
 
     /**
      * @brief Starting-point gate analysis: iterative root selection
+     * @param anytime if true, the analysis stops at the deadline of the budget of the current thread instead of throwing,
+     * the gate formula then contains the gates recognized so far (see isPartial())
      */
-    void analyze() {
-        std::vector<Cl*> root_clauses = index.estimateRoots();
-
-        for (unsigned count = 0; count < max_ && !root_clauses.empty(); count++) {
-            std::vector<Lit> candidates;
-            for (Cl* clause : root_clauses) {
-                gate_formula.addRoot(clause);
-                candidates.insert(candidates.end(), clause->begin(), clause->end());
-            }
+    void analyze(bool anytime = false) {
+        try {
+            std::vector<Cl*> root_clauses = index.estimateRoots();
+
+            for (unsigned count = 0; count < max_ && !root_clauses.empty(); count++) {
+                std::vector<Lit> root_literals;
+                for (Cl* clause : root_clauses) {
+                    gate_formula.addRoot(clause);
+                    root_literals.insert(root_literals.end(), clause->begin(), clause->end());
+                }
 
-            gate_recognition(candidates);
+                gate_recognition(root_literals);
 
-            root_clauses = index.estimateRoots();
+                root_clauses = index.estimateRoots();
+            }
+            // roots beyond the limit were removed from the index already
+            gate_formula.remainder.insert(gate_formula.remainder.end(), root_clauses.begin(), root_clauses.end());
+        } catch (const TimeLimitExceeded&) {
+            // thrown between gates, gate formula and index are consistent
+            if (!anytime) throw;
+            partial = true;
         }
 
-        std::unordered_set<Cl*> remainder;
+        // runs after the deadline, too: sort and unique is faster than hashing all occurrences
+        std::vector<Cl*> remainder;
         for (size_t lit = 0; lit < index.size(); lit++) {
-            remainder.insert(index[lit].begin(), index[lit].end());
+            ClauseSpan occurrences = index[lit];
+            remainder.insert(remainder.end(), occurrences.begin(), occurrences.end());
         }
+        std::sort(remainder.begin(), remainder.end());
+        remainder.erase(std::unique(remainder.begin(), remainder.end()), remainder.end());
         gate_formula.remainder.insert(gate_formula.remainder.end(), remainder.begin(), remainder.end());
     }
 
@@ -103,28 +171,67 @@ class GateAnalyzer {
      * 
      * @param roots 
      */
-    void gate_recognition(std::vector<Lit> roots) {
+    void gate_recognition(const std::vector<Lit>& roots) {
         // std::cerr << "c Starting gate-recognition with roots: " << roots << std::endl;
-        std::vector<Lit> candidates { roots.begin(), roots.end() };
-        std::unordered_set<Lit> frontier;
+        candidates.assign(roots.begin(), roots.end());
         while (!candidates.empty()) {  // breadth_ first search is important here
             // std::cout << "Number of Candidates: " << candidates.size() << std::endl;
+            frontier.clear();
+            in_frontier.clear();
+            if (semantic && solvers->size() > 1) speculate();
+            size_t next_speculation = 0;
             for (Lit candidate : candidates) {
-                if (checkAddGate(candidate)) {
-                    Gate& gate = gate_formula.getGate(candidate);
-                    index.remove(gate.fwd);
-                    index.remove(gate.bwd);
-                    frontier.insert(gate.inp.begin(), gate.inp.end());
+                ResourceBudget::checkpoint();
+                const Speculation* speculation = nullptr;
+                if (next_speculation < speculations.size() && speculations[next_speculation].out == candidate) {
+                    speculation = &speculations[next_speculation++];
+                }
+                if (checkAddGate(candidate, speculation)) {
+                    const Gate& gate = gate_formula.getGate(candidate);
+                    index.remove(gate_formula.fwd(gate));
+                    index.remove(gate_formula.bwd(gate));
+                    for (Lit lit : gate_formula.inp(gate)) {
+                        if (!in_frontier[lit]) {
+                            in_frontier.set(lit);
+                            frontier.push_back(lit);
+                        }
+                    }
                 }
             }
             // std::cout << "frontier size " << frontier.size() << std::endl;
-            candidates.clear();
-            candidates.insert(candidates.end(), frontier.begin(), frontier.end());
-            frontier.clear();
+            std::swap(candidates, frontier);
+        }
+        speculations.clear();
+    }
+
+    /**
+     * @brief Semantic checks of all candidates of the level which need a SAT call at the start of the level,
+     * distributed over the solver pool
+     */
+    void speculate() {
+        speculations.clear();
+        for (Lit out : candidates) {
+            ResourceBudget::checkpoint();
+            if (index[~out].size() > 1 && index[out].size() > 1 && index.isBlockedSet(out) && fStructural(out) == NONE) {
+                ClauseSpan fwd = index[~out], bwd = index[out];
+                if (filter.truthTable(out, fwd, bwd) != 0 || filter.propagate(out, fwd, bwd) != 0) continue;
+                speculations.push_back({ out, std::vector<Cl*>(fwd.begin(), fwd.end()), fwd.size(), 0 });
+                speculations.back().clauses.insert(speculations.back().clauses.end(), bwd.begin(), bwd.end());
+            }
+        }
+        if (speculations.size() < 2) {  // nothing to parallelize
+            speculations.clear();
+            return;
         }
+        solvers->run(speculations.size(), [this] (size_t i, unsigned solver) {
+            Speculation& s = speculations[i];
+            Cl* const* mid = s.clauses.data() + s.n_fwd;
+            s.result = solvers->check(solver, s.out, ClauseSpan(s.clauses.data(), mid), ClauseSpan(mid, s.clauses.data() + s.clauses.size()));
+        });
+        GBDC_PROFILE_COUNT(SAT_CALLS, speculations.size());
     }
 
-    std::vector<Lit> getInputLiterals(Lit output, const For& clauses) {
+    std::vector<Lit> getInputLiterals(Lit output, ClauseSpan clauses) {
         std::vector<Lit> inp;
         for (Cl* clause : clauses) {
             unsigned pos = 0;  // reset insert position for each clause
@@ -150,44 +257,41 @@ class GateAnalyzer {
         return inp;
     }
 
-    unsigned constrainSameInputVariables(Lit o, const For& fwd, const For& bwd) {
+    unsigned constrainSameInputVariables(Lit o, ClauseSpan fwd, ClauseSpan bwd) {
         // check if fwd and bwd constrain exactly the same inputs, return 0 on failure, otherwise return number of input variables
-        std::unordered_set<Var> fwd_vars;
-        std::unordered_set<Var> bwd_vars;
-        for (Cl* c : fwd) for (Lit l : *c) if (l != ~o) fwd_vars.insert(l.var());
-        for (Cl* c : bwd) for (Lit l : *c) if (l != o) {
-            bool inserted = std::get<1>(bwd_vars.insert(l.var()));
-            if (inserted && !fwd_vars.count(l.var())) {  // ensure: bwd_vars \subseteq fwd_vars
+        fwd_vars.clear();
+        bwd_vars.clear();
+        unsigned n_fwd = 0, n_bwd = 0;
+        for (Cl* c : fwd) for (Lit l : *c) if (l != ~o && !fwd_vars[l.var()]) {
+            fwd_vars.set(l.var());
+            ++n_fwd;
+        }
+        for (Cl* c : bwd) for (Lit l : *c) if (l != o && !bwd_vars[l.var()]) {
+            if (!fwd_vars[l.var()]) {  // ensure: bwd_vars \subseteq fwd_vars
                 return 0;
             }
+            bwd_vars.set(l.var());
+            ++n_bwd;
         }
-        if (fwd_vars.size() > bwd_vars.size()) {  // ensure: fwd_vars \subseteq bwd_vars
+        if (n_fwd > n_bwd) {  // ensure: fwd_vars \subseteq bwd_vars
             return 0;
         }
-        return fwd_vars.size();
+        return n_fwd;
     }
 
     /**
      * @brief checks if index contains a gate definition for the given candidate output and adds gate if positive
+     * @param speculation result of the semantic check of out at the start of the level, may be nullptr
      * @return true if clauses encode gate, false otherwise
      */
-    bool checkAddGate(Lit out) {
+    bool checkAddGate(Lit out, const Speculation* speculation = nullptr) {
         // std::cout << "check add gate " << out << std::endl;
         if (index[~out].size() > 0 && index.isBlockedSet(out)) {
-            GateType type = NONE;
-
-            if (gate_formula.isNestedMonotonic(out)) {
-                type = MONO;
-            } else if (patterns) {
-                unsigned input_size = constrainSameInputVariables(out, index[~out], index[out]);
-                if (input_size > 0) {
-                    type = fPattern(out, index[~out], index[out], input_size);
-                }
-            }
+            GateType type = fStructural(out);
 
             if (type == NONE && semantic) {
                 if (index[~out].size() > 1 && index[out].size() > 1) {  // case excluded by patterns
-                    type = fSemantic(out, index[~out], index[out]);
+                    type = fSemantic(out, index[~out], index[out], speculation);
                 }
             }
 
@@ -199,10 +303,20 @@ class GateAnalyzer {
         return false;
     }
 
+    // nested monotonicity or clause patterns, precondition: fwd blocks bwd on output literal o
+    GateType fStructural(Lit o) {
+        if (gate_formula.isNestedMonotonic(o)) return MONO;
+        if (patterns) {
+            unsigned input_size = constrainSameInputVariables(o, index[~o], index[o]);
+            if (input_size > 0) return fPattern(o, index[~o], index[o], input_size);
+        }
+        return NONE;
+    }
+
     // clause patterns of full encoding
     // precondition: fwd blocks bwd on output literal o
     // fwd and bwd constrain same input variables
-    GateType fPattern(Lit o, const For& fwd, const For& bwd, unsigned input_size) {
+    GateType fPattern(Lit o, ClauseSpan fwd, ClauseSpan bwd, unsigned input_size) {
         // detect or gates
         if (fwd.size() == 1 && fixedClauseSize(bwd, 2)) {
             if (input_size == 1) return TRIV;
@@ -214,7 +328,7 @@ class GateAnalyzer {
         }
         // under the preconditions (blocked set, same inputs, absence of redundancy) the follwing holds:
         // 2^n blocked clauses of size n+1 represent all input combinations with an output literal
-        // Note that CNFFormula's input sanitizer takes care of inner-clause redundency but does not check for duplicate clauses!
+        // Note that CNFFormula's input sanitizer takes care of inner-clause redundency, duplicate clauses are only removed if deduplication is enabled!
         if (fwd.size() + bwd.size() == std::uint64_t(1) << input_size) {
             if (fixedClauseSize(fwd, input_size+1) && fixedClauseSize(bwd, input_size+1)) {
                 if (input_size == 2 && fwd.size() == bwd.size()) return EQIV;
@@ -224,29 +338,35 @@ class GateAnalyzer {
         return NONE;
     }
 
-    GateType fSemantic(Lit o, const For& fwd, const For& bwd) {
+    /**
+     * @brief Semantic check: fwd and bwd without the output literal are unsatisfiable (the output is defined for all inputs)
+     * Tiers: truth table (up to six inputs), bounded unit propagation, SAT call.
+     * The result of a matching speculation is reused, otherwise the SAT call runs on the first solver of the pool.
+     * @throw TimeLimitExceeded if the budget is exhausted, a check which only exceeds its own time limit is counted as aborted
+     */
+    GateType fSemantic(Lit o, ClauseSpan fwd, ClauseSpan bwd, const Speculation* speculation) {
         // std::cout << "Semantic check for " << fwd.size() + bwd.size() << " clauses" << std::endl;
-        // std::cout << fwd << std::endl;
-        // std::cout << bwd << std::endl;
-        for (const For& f : { fwd, bwd }) {
-            for (Cl* cl : f) {
-                for (Lit lit : *cl) {
-                    if (lit.var() != o.var()) {
-                        ipasir_add(S, lit.toDimacs());
-                    } else {
-                        ipasir_add(S, lit.positive().toDimacs());
-                    }
-                }
-                ipasir_add(S, 0);
+        int result;
+        if ((result = filter.truthTable(o, fwd, bwd)) != 0) {
+            GBDC_PROFILE_COUNT(TRUTH_TABLES, 1);
+        } else if ((result = filter.propagate(o, fwd, bwd)) != 0) {
+            GBDC_PROFILE_COUNT(PROPAGATIONS, 1);
+        } else {
+            if (speculation != nullptr && speculation->matches(fwd, bwd)) {
+                result = speculation->result;
+            } else {
+                GBDC_PROFILE_COUNT(SAT_CALLS, 1);
+                result = solvers->check(0, o, fwd, bwd);
+            }
+            if (result == 0) {  // interrupted by terminate callback
+                if (solvers->expired()) throw TimeLimitExceeded();
+                ++n_aborted;
             }
         }
-        ipasir_assume(S, o.negative().toDimacs());
-        int result = ipasir_solve(S);
-        ipasir_add(S, o.positive().toDimacs());
         return result == 20 ? GENERIC : NONE;
     }
 
-    bool fixedClauseSize(const For& f, unsigned int n) {
+    bool fixedClauseSize(ClauseSpan f, unsigned int n) {
         for (Cl* c : f) if (c->size() != n) return false;
         return true;
     }
@@ -0,0 +1,309 @@
+/**
+ * MIT License
+ * Copyright (c) 2024 Markus Iser
+ */
+
+#ifndef SRC_EXTRACT_GATES_GATEFILE_H_
+#define SRC_EXTRACT_GATES_GATEFILE_H_
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "src/util/SolverTypes.h"
+#include "src/util/OccurrenceIndex.h"
+#include "src/extract/gates/GateFormula.h"
+
+/**
+ * Binary gate structure files, similar to binary AIGER:
+ * an ASCII header "gates <version> <vars> <roots> <gates> <remainder>\n" is followed by the roots,
+ * the gates in the order of their recognition and the remainder clauses.
+ *
+ * All numbers are unsigned varints (7 bits per byte, least significant first, high bit set if more bytes follow).
+ * Literals are delta-encoded against the previous literal of the same record, deltas are zigzag-encoded.
+ *
+ * clause: <size> <lit>...  (sorted, the first literal relative to the base literal of the record)
+ * root and remainder clauses: clause with base literal 0
+ * gate: <type * 2 + notMono> <out> <n_inp> <inp>... <n_fwd> <n_bwd> <clause>...
+ *       (out relative to the previous output, inp and gate clauses relative to out, the output literal is omitted in the gate clauses)
+ */
+namespace GateFile {
+
+constexpr unsigned version = 1;
+
+inline uint64_t zigzag(Lit lit, Lit base) {
+    int64_t delta = static_cast<int64_t>(lit.x) - static_cast<int64_t>(base.x);
+    return delta < 0 ? 2 * static_cast<uint64_t>(-delta) - 1 : 2 * static_cast<uint64_t>(delta);
+}
+
+inline Lit unzigzag(uint64_t code, Lit base) {
+    Lit lit;
+    lit.x = code & 1 ? base.x - static_cast<unsigned>((code + 1) / 2) : base.x + static_cast<unsigned>(code / 2);
+    return lit;
+}
+
+}  // namespace GateFile
+
+/**
+ * @brief Streaming writer of gate structures, "-" writes to stdout
+ */
+class GateWriter {
+    FILE* file;
+    std::vector<unsigned char> buffer;
+    size_t pos;
+    std::vector<Lit> lits;  // sorted literals of the current clause
+
+    static constexpr size_t capacity = 1 << 16;
+
+    void flush() {
+        if (fwrite(buffer.data(), 1, pos, file) != pos) {
+            throw std::runtime_error("Error writing gate structure");
+        }
+        pos = 0;
+    }
+
+    inline void number(uint64_t value) {
+        if (pos + 10 > capacity) flush();
+        while (value > 0x7F) {
+            buffer[pos++] = static_cast<unsigned char>(value | 0x80);
+            value >>= 7;
+        }
+        buffer[pos++] = static_cast<unsigned char>(value);
+    }
+
+    template <typename Literals>
+    void literals(const Literals& list, Lit base) {
+        for (Lit lit : list) {
+            number(GateFile::zigzag(lit, base));
+            base = lit;
+        }
+    }
+
+    // clause without the literals of variable omit
+    void clause(const Cl& clause, Lit base, Var omit) {
+        lits.clear();
+        for (Lit lit : clause) {
+            if (lit.var() != omit) lits.push_back(lit);
+        }
+        std::sort(lits.begin(), lits.end());  // clauses of normalized roots are not sorted
+        number(lits.size());
+        literals(lits, base);
+    }
+
+ public:
+    explicit GateWriter(const char* output) : file(nullptr), buffer(capacity), pos(0), lits() {
+        if (strcmp(output, "-") == 0) {
+            file = stdout;
+        } else {
+            file = fopen(output, "wb");
+            if (file == nullptr) throw std::runtime_error(std::string("Error opening file: ") + output);
+        }
+    }
+
+    ~GateWriter() {
+        try {
+            close();
+        } catch (const std::exception&) { }  // incomplete output after an error
+    }
+
+    GateWriter(const GateWriter&) = delete;
+    GateWriter& operator=(const GateWriter&) = delete;
+
+    void close() {
+        if (file != nullptr) flush();
+        if (file != nullptr && file != stdout) fclose(file);
+        file = nullptr;
+    }
+
+    void write(const GateFormula& formula) {
+        std::vector<const Gate*> order;  // recognition order, i.e., the order of the clauses of the gates
+        for (const Gate& gate : formula) {
+            if (gate.isDefined()) order.push_back(&gate);
+        }
+        std::sort(order.begin(), order.end(), [] (const Gate* a, const Gate* b) {
+            return a->clauses_begin < b->clauses_begin || (a->clauses_begin == b->clauses_begin && a->inputs_begin < b->inputs_begin);
+        });
+
+        std::string header = "gates " + std::to_string(GateFile::version) + " " + std::to_string(formula.nVars() - 2) + " "
+            + std::to_string(formula.nRoots()) + " " + std::to_string(order.size()) + " " + std::to_string(formula.remainder.size()) + "\n";
+        if (pos + header.size() > capacity) flush();
+        memcpy(buffer.data() + pos, header.data(), header.size());
+        pos += header.size();
+
+        for (const Cl* root : formula.roots) {
+            clause(*root, lit_Undef, var_Undef);
+        }
+        Lit previous = lit_Undef;
+        for (const Gate* gate : order) {
+            ClauseSpan fwd = formula.fwd(*gate), bwd = formula.bwd(*gate);
+            Span<const Lit> inp = formula.inp(*gate);
+            number(2 * gate->type + (gate->notMono ? 1 : 0));
+            number(GateFile::zigzag(gate->out, previous));
+            number(inp.size());
+            literals(inp, gate->out);
+            number(fwd.size());
+            number(bwd.size());
+            for (ClauseSpan f : { fwd, bwd }) {
+                for (const Cl* cl : f) clause(*cl, gate->out, gate->out.var());
+            }
+            previous = gate->out;
+        }
+        for (const Cl* cl : formula.remainder) {
+            clause(*cl, lit_Undef, var_Undef);
+        }
+    }
+};
+
+/**
+ * @brief Reader of gate structures written by GateWriter
+ * The reader owns the clauses of the gate formula, which is valid for the lifetime of the reader.
+ */
+class GateReader {
+    struct Header {
+        unsigned vars = 0;
+        size_t roots = 0, gates = 0, remainder = 0;
+        size_t length = 0;  // including the newline
+    };
+
+    std::vector<unsigned char> data;
+    Header header;
+    size_t pos;
+    std::vector<Cl*> clauses;  // owned
+    std::vector<Cl*> fwd, bwd;  // of the current gate
+    std::vector<Lit> inp;
+    GateFormula formula;
+
+    [[noreturn]] static void error(const std::string& what) {
+        throw std::runtime_error("Error reading gate structure: " + what);
+    }
+
+    static std::vector<unsigned char> load(const char* filename) {
+        FILE* file = fopen(filename, "rb");
+        if (file == nullptr) throw std::runtime_error(std::string("Error opening file: ") + filename);
+        std::vector<unsigned char> data;
+        unsigned char chunk[1 << 16];
+        for (size_t n; (n = fread(chunk, 1, sizeof(chunk), file)) > 0; ) {
+            data.insert(data.end(), chunk, chunk + n);
+        }
+        fclose(file);
+        return data;
+    }
+
+    static Header parse(const std::vector<unsigned char>& data) {
+        Header header;
+        unsigned ver = 0;
+        int len = 0;
+        std::string line(reinterpret_cast<const char*>(data.data()), std::min<size_t>(data.size(), 128));
+        if (sscanf(line.c_str(), "gates %u %u %zu %zu %zu%n", &ver, &header.vars, &header.roots, &header.gates, &header.remainder, &len) != 5
+                || static_cast<size_t>(len) >= data.size() || data[len] != '\n') {
+            error("invalid header");
+        }
+        if (ver != GateFile::version) error("unsupported version " + std::to_string(ver));
+        header.length = len + 1;
+        return header;
+    }
+
+    inline uint64_t number() {
+        uint64_t value = 0;
+        for (unsigned shift = 0; shift < 64; shift += 7) {
+            if (pos == data.size()) error("unexpected end of file");
+            unsigned char byte = data[pos++];
+            value |= static_cast<uint64_t>(byte & 0x7F) << shift;
+            if (!(byte & 0x80)) return value;
+        }
+        error("invalid number");
+    }
+
+    inline Lit literal(Lit base) {
+        Lit lit = GateFile::unzigzag(number(), base);
+        if (lit.var() == var_Undef || lit.var().id >= formula.nVars()) error("invalid literal");
+        return lit;
+    }
+
+    // number of elements of a list, each element takes at least one byte
+    inline size_t length(const char* what) {
+        uint64_t size = number();
+        if (size > data.size() - pos) error(std::string("invalid ") + what);
+        return static_cast<size_t>(size);
+    }
+
+    // clause with the literal out inserted at its sorted position (if defined)
+    Cl* clause(Lit base, Lit out) {
+        size_t size = length("clause size");
+        Cl* cl = new Cl();
+        clauses.push_back(cl);
+        cl->reserve(size + (out != lit_Undef ? 1 : 0));
+        for (size_t i = 0; i < size; ++i) {
+            base = literal(base);
+            cl->push_back(base);
+        }
+        if (out != lit_Undef) cl->insert(std::upper_bound(cl->begin(), cl->end(), out), out);
+        return cl;
+    }
+
+    void read() {
+        for (size_t i = 0; i < header.roots; ++i) {
+            formula.addRoot(clause(lit_Undef, lit_Undef));
+        }
+        Lit previous = lit_Undef;
+        for (size_t i = 0; i < header.gates; ++i) {
+            uint64_t code = number();
+            if (code / 2 > FULL) error("invalid gate type");
+            Lit out = literal(previous);
+            if (formula.isGateOutput(out)) error("duplicate gate output");
+            inp.resize(length("number of inputs"));
+            Lit base = out;
+            for (Lit& lit : inp) lit = base = literal(base);
+            fwd.resize(length("number of clauses"));
+            bwd.resize(length("number of clauses"));
+            for (Cl*& cl : fwd) cl = clause(out, ~out);
+            for (Cl*& cl : bwd) cl = clause(out, out);
+            formula.addGate(static_cast<GateType>(code / 2), out, fwd, bwd, inp);
+            formula.getGate(out).notMono = code & 1;
+            previous = out;
+        }
+        for (size_t i = 0; i < header.remainder; ++i) {
+            formula.remainder.push_back(clause(lit_Undef, lit_Undef));
+        }
+        if (pos != data.size()) error("unexpected data at end of file");
+        // addGate() marked negated inputs by the monotonicity it derived for the order of the file, redo the marks with the stored one
+        std::fill(formula.inputs.begin(), formula.inputs.end(), false);
+        for (const Cl* root : formula.roots) {
+            for (Lit lit : *root) formula.inputs[lit] = true;
+        }
+        for (const Gate& gate : formula) {
+            for (Lit lit : formula.inp(gate)) {
+                formula.inputs[lit] = true;
+                if (gate.notMono) formula.inputs[~lit] = true;
+            }
+        }
+    }
+
+ public:
+    explicit GateReader(const char* filename) : data(load(filename)), header(parse(data)), pos(header.length),
+     clauses(), fwd(), bwd(), inp(), formula(header.vars, 0) {
+        try {
+            read();
+        } catch (...) {
+            for (Cl* cl : clauses) delete cl;
+            throw;
+        }
+    }
+
+    ~GateReader() {
+        for (Cl* cl : clauses) delete cl;
+    }
+
+    GateReader(const GateReader&) = delete;
+    GateReader& operator=(const GateReader&) = delete;
+
+    const GateFormula& getGateFormula() const {
+        return formula;
+    }
+};
+
+#endif  // SRC_EXTRACT_GATES_GATEFILE_H_
@@ -20,12 +20,15 @@ OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWA
 #ifndef SRC_GATES_GATEFORMULA_H_
 #define SRC_GATES_GATEFORMULA_H_
 
+#include <cstdint>
 #include <cstdlib>
 #include <algorithm>
 #include <vector>
 #include <set>
+#include <utility>
 
 #include "src/util/CNFFormula.h"
+#include "src/util/OccurrenceIndex.h"
 #include "src/util/Stamp.h"
 
 
@@ -41,12 +44,19 @@ enum GateType {
 };
 
 
+/**
+ * @brief Gate of a GateFormula, its clauses and inputs are ranges in the shared arrays of the formula
+ * (see GateFormula::fwd(), GateFormula::bwd() and GateFormula::inp())
+ */
 struct Gate {
     GateType type = NONE;
     Lit out = lit_Undef;
-    For fwd, bwd;
     bool notMono = false;
-    std::vector<Lit> inp;
+    uint32_t clauses_begin = 0;  // fwd is clauses[clauses_begin, clauses_mid)
+    uint32_t clauses_mid = 0;  // bwd is clauses[clauses_mid, clauses_end)
+    uint32_t clauses_end = 0;
+    uint32_t inputs_begin = 0;  // inp is literals[inputs_begin, inputs_end)
+    uint32_t inputs_end = 0;
 
     inline bool isDefined() const { return out != lit_Undef; }
     inline bool hasNonMonotonicParent() const { return notMono; }
@@ -59,30 +69,43 @@ class GateFormula {
     std::vector<char> inputs;  // mark literals which are used as input to a gate (used in detection of monotonicity)
     std::vector<char> direct;  // non-transitive version of inputs
     std::vector<Gate> gates;  // stores gate-struct for every output
+    std::vector<Cl*> clauses;  // fwd and bwd clauses of all gates in the order of their recognition
+    std::vector<Lit> literals;  // inputs of all gates in the order of their recognition
     For remainder;  // stores clauses remaining outside of recognized gate-structure
     bool artificialRoot;  // top-level unit-clause that can be generated by normalizeRoots()
     unsigned verbose_;
 
     explicit GateFormula(unsigned verbose) :
-     roots(), gates(), artificialRoot(false), verbose_(verbose)
+     roots(), gates(), clauses(), literals(), artificialRoot(false), verbose_(verbose)
     { }
 
     explicit GateFormula(unsigned nVars, unsigned verbose) :
-     roots(), gates(), artificialRoot(false), verbose_(verbose) {
-        inputs.resize(2 + 2*nVars, false);
-        direct.resize(2 + 2*nVars, false);
+     roots(), gates(), clauses(), literals(), artificialRoot(false), verbose_(verbose) {
+        inputs.resize(4 + 2*nVars, false);  // including the variable of an artificial root
+        direct.resize(4 + 2*nVars, false);
         gates.resize(2 + nVars);
     }
 
     ~GateFormula() {
         if (artificialRoot) {
-            for (Cl* clause : getGate(getRoot()).fwd) {
+            for (Cl* clause : fwd(getGate(getRoot()))) {
                 delete clause;
             }
             delete *roots.begin();
         }
     }
 
+    // not copyable: the clauses of an artificial root are owned by the gate formula
+    GateFormula(const GateFormula&) = delete;
+    GateFormula& operator=(const GateFormula&) = delete;
+
+    GateFormula(GateFormula&& other) noexcept :
+     roots(std::move(other.roots)), inputs(std::move(other.inputs)), direct(std::move(other.direct)),
+     gates(std::move(other.gates)), clauses(std::move(other.clauses)), literals(std::move(other.literals)),
+     remainder(std::move(other.remainder)), artificialRoot(other.artificialRoot), verbose_(other.verbose_) {
+        other.artificialRoot = false;
+    }
+
     void addRoot(Cl* clause) {
         roots.push_back(clause);
         for (Lit l : *clause) inputs[l] = true;
@@ -92,16 +115,21 @@ class GateFormula {
         return !inputs[lit] || !inputs[~lit];
     }
 
-    void addGate(GateType type, Lit o, For fwd, For bwd, std::vector<Lit> inp) {
+    void addGate(GateType type, Lit o, ClauseSpan fwd, ClauseSpan bwd, const std::vector<Lit>& inp) {
         Gate& gate = gates[o.var()];
         gate.type = type;
         gate.out = o;
-        gate.fwd.swap(fwd);
-        gate.bwd.swap(bwd);
         gate.notMono = !isNestedMonotonic(o);
-        gate.inp.swap(inp);
-
-        for (Lit lit : gate.inp) {
+        gate.clauses_begin = clauses.size();
+        clauses.insert(clauses.end(), fwd.begin(), fwd.end());
+        gate.clauses_mid = clauses.size();
+        clauses.insert(clauses.end(), bwd.begin(), bwd.end());
+        gate.clauses_end = clauses.size();
+        gate.inputs_begin = literals.size();
+        literals.insert(literals.end(), inp.begin(), inp.end());
+        gate.inputs_end = literals.size();
+
+        for (Lit lit : inp) {
             inputs[lit] = true;
             direct[lit] = true;
             if (gate.notMono) inputs[~lit] = true;
@@ -110,9 +138,9 @@ class GateFormula {
         if (verbose_) {
             unsigned otype = gate.type == MONO ? 10 : gate.type == GENERIC ? 0 : gate.type == TRIV ? 1 : gate.type == AND ? 2 : gate.type == OR ? 3 : 4;
             std::cout << "GateType " << otype << " OutLit " << gate.out << std::endl;
-            for (Cl* cl : gate.fwd) std::cout << *cl << "0 ";
+            for (Cl* cl : fwd) std::cout << *cl << "0 ";
             std::cout << std::endl;
-            for (Cl* cl : gate.bwd) std::cout << *cl << "0 ";
+            for (Cl* cl : bwd) std::cout << *cl << "0 ";
             std::cout << std::endl << "endG" << std::endl;
         }
     }
@@ -121,6 +149,22 @@ class GateFormula {
         return gates[output.var()];
     }
 
+    const Gate& getGate(Lit output) const {
+        return gates[output.var()];
+    }
+
+    inline ClauseSpan fwd(const Gate& gate) const {
+        return ClauseSpan(clauses.data() + gate.clauses_begin, clauses.data() + gate.clauses_mid);
+    }
+
+    inline ClauseSpan bwd(const Gate& gate) const {
+        return ClauseSpan(clauses.data() + gate.clauses_mid, clauses.data() + gate.clauses_end);
+    }
+
+    inline Span<const Lit> inp(const Gate& gate) const {
+        return Span<const Lit>(literals.data() + gate.inputs_begin, literals.data() + gate.inputs_end);
+    }
+
     inline bool isGateOutput(Lit output) const {
         return gates[output.var()].isDefined();
     }
@@ -164,7 +208,7 @@ class GateFormula {
     }
 
     template <template <typename> typename Alloc = std::allocator>
-    std::vector<Lit, Alloc<Lit>> getRoots() {
+    std::vector<Lit, Alloc<Lit>> getRoots() const {
         std::vector<Lit, Alloc<Lit>> result;
         for (Cl* root : roots) {
             result.insert(result.end(), root->begin(), root->end());
@@ -185,19 +229,24 @@ class GateFormula {
      */
     void normalizeRoots() {
         Var root = Var(gates.size()-1);
-        gates[root].out = Lit(root, false);
-        gates[root].notMono = false;
+        Gate& gate = gates[root];
+        gate.out = Lit(root, false);
+        gate.notMono = false;
         std::set<Lit> inp;
         roots.insert(roots.end(), remainder.begin(), remainder.end());
         remainder.clear();
+        gate.clauses_begin = clauses.size();
         for (Cl* c : roots) {
             inp.insert(c->begin(), c->end());
             c->push_back(Lit(root, true));
-            gates[root].fwd.push_back(new Cl(*c));
+            clauses.push_back(new Cl(*c));
         }
-        gates[root].inp.insert(gates[root].inp.end(), inp.begin(), inp.end());
+        gate.clauses_mid = gate.clauses_end = clauses.size();
+        gate.inputs_begin = literals.size();
+        literals.insert(literals.end(), inp.begin(), inp.end());
+        gate.inputs_end = literals.size();
         roots.clear();
-        roots.push_back(new Cl({gates[root].out}));
+        addRoot(new Cl({gate.out}));
         artificialRoot = true;
     }
 
@@ -209,28 +258,30 @@ class GateFormula {
     For getPrunedProblem(const std::vector<uint8_t>& model) {
         For result(roots.begin(), roots.end());
 
-        std::vector<Lit> literals;
+        std::vector<Lit> pending;
         for (const Cl* c : roots) {
-            literals.insert(literals.end(), c->begin(), c->end());
+            pending.insert(pending.end(), c->begin(), c->end());
         }
-        std::sort(literals.begin(), literals.end());
-        literals.erase(std::unique(literals.begin(), literals.end()), literals.end());
+        std::sort(pending.begin(), pending.end());
+        pending.erase(std::unique(pending.begin(), pending.end()), pending.end());
 
         Stamp<uint8_t> visited { gates.size() };
 
-        while (literals.size() > 0) {
-            Lit o = literals.back();
-            literals.pop_back();
-            Gate gate = gates[o.var()];
+        while (pending.size() > 0) {
+            Lit o = pending.back();
+            pending.pop_back();
+            const Gate& gate = gates[o.var()];
 
             if (!gate.isDefined()) continue;
 
             if (!visited[o.var()] && (gate.hasNonMonotonicParent() || model[o])) {  // Skip "don't cares"
-                std::copy(gate.fwd.begin(), gate.fwd.end(), result.end());
+                ClauseSpan f = fwd(gate), b = bwd(gate);
+                result.insert(result.end(), f.begin(), f.end());
                 if (gate.hasNonMonotonicParent()) {  // BCE
-                    std::copy(gate.bwd.begin(), gate.bwd.end(), result.end());
+                    result.insert(result.end(), b.begin(), b.end());
                 }
-                literals.insert(literals.end(), gate.inp.begin(), gate.inp.end());
+                Span<const Lit> i = inp(gate);
+                pending.insert(pending.end(), i.begin(), i.end());
                 visited.set(o.var());
             }
         }
@@ -20,70 +20,176 @@ OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWA
 #ifndef SRC_GATES_OCCURRENCELIST_H_
 #define SRC_GATES_OCCURRENCELIST_H_
 
+#include <cstdint>
+#include <functional>
+#include <queue>
 #include <vector>
 #include <set>
 #include <limits>
 #include <utility>
+#include <algorithm>
 
 #include "src/util/CNFFormula.h"
+#include "src/util/OccurrenceIndex.h"
+#include "src/util/Profile.h"
+#include "src/util/Stamp.h"
 
+/**
+ * @brief Occurrence lists with lazy removal, default index backend of GateAnalyzer
+ * Root selection takes the clauses of the highest literal with occurrences, or with prioritized root selection
+ * the clauses of the literal with the fewest occurrences whose complement still occurs (see PriorityOccurrenceList).
+ */
 class OccurrenceList {
     const CNFFormula& problem;
 
-    std::vector<For> index;
+    // occurrences of literals in non-unit clauses, the remaining occurrences of literal l
+    // are kept in order at the front of its list: index[l][0, index.length(l))
+    OccurrenceLists index;
     std::vector<Cl*> unitc;
     Lit max_literal;
 
-#define CLAUSES_ARE_SORTED
-#ifdef CLAUSES_ARE_SORTED
-    bool isBlocked(Lit o, const Cl& c1, const Cl& c2) const {  // assert o \in c1 and ~o \in c2
-        for (unsigned i = 0, j = 0; i < c1.size() && j < c2.size(); c1[i] < c2[j] ? ++i : ++j) {
-            if (c1[i] != o && c1[i] == ~c2[j]) return true;
+    // removal is lazy: remove() records the removed occurrences of literal l in a list (in removals, head pending[l]),
+    // and list l is compacted on its next access, such that each removal costs O(1) per literal;
+    // removals is cleared once no list is pending, lists which are not accessed again are compacted in bulk (see collect())
+    std::vector<std::pair<Cl*, unsigned>> removals;  // (clause, next entry + 1)
+    std::vector<unsigned> pending;  // first entry + 1, or 0
+    std::vector<Lit> pending_lits;  // literals which became pending since removals was cleared
+    size_t n_pending;
+    std::vector<Cl*> scratch;
+
+    void compact(size_t lit) {
+        Span<Cl*> occ = index.modify(lit);
+        Cl** begin = occ.begin();
+        Cl** end = occ.end();
+        unsigned entry = pending[lit];
+        pending[lit] = 0;
+        if (removals[entry - 1].second == 0) {  // single removal
+            Cl** it = std::find(begin, end, removals[entry - 1].first);
+            if (it != end) {
+                std::copy(it + 1, end, it);  // keep order of remaining occurrences
+                index.truncate(lit, occ.size() - 1);
+            }
+        } else {
+            scratch.clear();
+            for (; entry != 0; entry = removals[entry - 1].second) {
+                scratch.push_back(removals[entry - 1].first);
+            }
+            std::sort(scratch.begin(), scratch.end());
+            end = std::remove_if(begin, end, [this] (Cl* clause) { return std::binary_search(scratch.begin(), scratch.end(), clause); });
+            index.truncate(lit, end - begin);
+        }
+        if (--n_pending == 0) {
+            removals.clear();
+            pending_lits.clear();
         }
-        return false;
     }
-#else
-    bool isBlocked(Lit o, const Cl& c1, const Cl& c2) const {  // assert o \in c1 and ~o \in c2
-        for (Lit l1 : c1) if (l1 != o) for (Lit l2 : c2) if (l1 == ~l2) return true;
-        return false;
+
+    // compacts all pending lists once removals outgrows the number of literals,
+    // such that removals of lists which are not accessed again do not accumulate
+    void collect() {
+        if (removals.size() <= index.size()) return;
+        for (size_t i = 0; i < pending_lits.size(); ++i) {  // the last compaction clears pending_lits
+            if (pending[pending_lits[i]] != 0) compact(pending_lits[i]);
+        }
     }
-#endif
 
- public:
-    explicit OccurrenceList(const CNFFormula& problem_) : problem(problem_), unitc(), max_literal(problem.nVars(), true) {
-        index.resize(2 + 2 * problem.nVars());
+    // prioritized root selection: min-heap of literal keys (see key()) with lazy deletion,
+    // literals whose counts changed get a new key before the next selection, keys which differ from the current key of their literal are stale
+    bool prioritized;
+    std::vector<unsigned> counts;  // remaining occurrences, updated on remove() unlike the lengths of the lists
+    std::priority_queue<uint64_t, std::vector<uint64_t>, std::greater<uint64_t>> queue;
+    std::vector<Lit> changed;
+    Stamp<uint32_t> is_changed;
+
+    inline void change(Lit lit) {
+        if (!is_changed[lit]) {
+            is_changed.set(lit);
+            changed.push_back(lit);
+        }
+    }
+
+    // literals whose complement occurs first, then fewer occurrences, then higher literals
+    inline uint64_t key(Lit lit) const {
+        uint64_t pure = counts[~lit] == 0 ? 1 : 0;
+        return pure << 63 | static_cast<uint64_t>(counts[lit]) << 32 | (std::numeric_limits<uint32_t>::max() - lit.x);
+    }
+
+    inline void push(Lit lit) {
+        if (counts[lit] > 0) queue.push(key(lit));
+    }
+
+    Lit getPriorityLiteral() {
+        for (Lit lit : changed) push(lit);
+        changed.clear();
+        is_changed.clear();
+        while (!queue.empty()) {
+            uint64_t top = queue.top();
+            queue.pop();
+            Lit lit;
+            lit.x = std::numeric_limits<uint32_t>::max() - static_cast<uint32_t>(top);
+            if (counts[lit] > 0 && key(lit) == top) return lit;
+        }
+        return lit_Undef;
+    }
+
+    // blocked-set check: literal marks and 64-bit literal signatures (Bloom filters) of clauses
+    Stamp<uint32_t> marks;
+    std::vector<uint64_t> signatures;
+
+    static inline uint64_t signature(Lit lit) {
+        return uint64_t(1) << (lit & 63);
+    }
 
+ public:
+    /**
+     * @param occurrences occurrence index of the non-unit clauses shared with other consumers, or nullptr to build an own index
+     * @param prioritized_ root selection by priority queue instead of by highest literal
+     */
+    explicit OccurrenceList(const CNFFormula& problem_, const OccurrenceIndex* occurrences = nullptr, bool prioritized_ = false)
+     : problem(problem_), index(problem_, occurrences), unitc(),
+     max_literal(problem.nVars(), true), removals(), pending(index.size(), 0), pending_lits(), n_pending(0), scratch(), prioritized(prioritized_), counts(), queue(),
+     changed(), is_changed(prioritized_ ? index.size() : 0), marks(index.size()), signatures() {
+        if (prioritized) {
+            counts.resize(index.size());
+            for (size_t lit = 0; lit < index.size(); ++lit) {
+                counts[lit] = index.length(lit);
+            }
+            std::vector<uint64_t> keys;
+            for (Lit lit = Lit(1, false); lit.x < index.size(); ++lit) {
+                if (counts[lit] > 0) keys.push_back(key(lit));
+            }
+            queue = decltype(queue)(std::greater<uint64_t>(), std::move(keys));  // heapify in O(n)
+        }
         for (Cl* clause : problem_) {
             if (clause->size() == 1) {
                 unitc.push_back(clause);
-            } else {
-                for (Lit lit : *clause) {
-                    index[lit].push_back(clause);
-                }
             }
         }
     }
 
     ~OccurrenceList() { }
 
-    void remove(const For& list) {
-        for (Cl* clause : list) for (Lit lit : *clause) {
-            if (!index[lit].empty()) {
-                // assert(std::find(index[lit].begin(), index[lit].end(), clause) != index[lit].end());
-                auto it = index[lit].begin();
-                while (*it != clause && it != index[lit].end()) {
-                    ++it;
+    void remove(ClauseSpan list) {
+        for (Cl* clause : list) {
+            if (clause->size() == 1) continue;  // units are not indexed
+            for (Lit lit : *clause) {
+                if (pending[lit] == 0) {
+                    pending_lits.push_back(lit);
+                    ++n_pending;
                 }
-                while (it+1 < index[lit].end()) {
-                    *it = *(it+1);
-                    ++it;
+                removals.emplace_back(clause, pending[lit]);
+                pending[lit] = removals.size();
+                if (prioritized) {  // removed clauses are live, i.e., each clause is removed at most once
+                    --counts[lit];
+                    change(lit);
+                    if (counts[lit] == 0) change(~lit);  // ~lit became pure
                 }
-                index[lit].erase(index[lit].end()-1, index[lit].end());
             }
         }
     }
 
-    inline const For& operator[] (size_t o) const {
+    inline ClauseSpan operator[] (size_t o) {
+        if (pending[o] != 0) compact(o);
         return index[o];
     }
 
@@ -91,12 +197,34 @@ class OccurrenceList {
         return index.size();
     }
 
-    inline bool isBlockedSet(Lit o) {
-        for (Cl* c1 : index[o]) {
-            for (Cl* c2 : index[~o]) {
-                if (!isBlocked(o, *c1, *c2)) {
-                    return false;
+    /**
+     * @brief true iff all pairs of clauses c1 \in index[o], c2 \in index[~o] are blocked on o,
+     * i.e., there is a literal l != o in c1 with ~l in c2
+     * Signatures reject most non-blocked pairs, the remaining pairs are checked against the marked literals of c1.
+     */
+    bool isBlockedSet(Lit o) {
+        GBDC_PROFILE_COUNT(BLOCKED_SET_CHECKS, 1);
+        ClauseSpan fwd = (*this)[o];
+        ClauseSpan bwd = (*this)[~o];
+        if (fwd.empty() || bwd.empty()) return true;
+        signatures.clear();  // negated literals of bwd[j] without ~o, computed on first use
+        for (Cl* c1 : fwd) {
+            uint64_t sig = 0;
+            for (Lit lit : *c1) if (lit != o) sig |= signature(lit);
+            bool marked = false;
+            for (size_t j = 0; j < bwd.size(); ++j) {
+                if (j == signatures.size()) {
+                    uint64_t sig2 = 0;
+                    for (Lit lit : *bwd[j]) if (lit != ~o) sig2 |= signature(~lit);
+                    signatures.push_back(sig2);
                 }
+                if ((sig & signatures[j]) == 0) return false;  // no clashing literal
+                if (!marked) {  // mark c1 lazily, only if a pair passes the signature test
+                    marks.clear();
+                    for (Lit lit : *c1) if (lit != o) marks.set(lit);
+                    marked = true;
+                }
+                if (std::none_of(bwd[j]->begin(), bwd[j]->end(), [this] (Lit lit) { return marks[~lit]; })) return false;
             }
         }
         return true;
@@ -104,15 +232,24 @@ class OccurrenceList {
 
     For estimateRoots() {
         For result {};
+        collect();
 
         if (unitc.size() > 0) {
             std::swap(result, unitc);
+        } else if (prioritized) {
+            Lit lit = getPriorityLiteral();
+            if (lit != lit_Undef) {
+                ClauseSpan occurrences = (*this)[lit];
+                result.assign(occurrences.begin(), occurrences.end());
+                remove(result);
+            }
         } else {
-            while (max_literal > 0 && index[max_literal].size() == 0) {
+            while (max_literal > 0 && (*this)[max_literal].size() == 0) {
                 --max_literal;
             }
             if (max_literal > 0) {
-                result.swap(index[max_literal]);
+                ClauseSpan occurrences = (*this)[max_literal];
+                result.assign(occurrences.begin(), occurrences.end());
                 remove(result);
             }
         }
@@ -121,4 +258,15 @@ class OccurrenceList {
     }
 };
 
+/**
+ * @brief OccurrenceList with prioritized root selection, index backend for GateAnalyzer<PriorityOccurrenceList>
+ * Root candidates are ordered by occurrence imbalance: the occurrences of a literal bound its unblocked clauses,
+ * which are none if its complement does not occur. This approximates BlockList::getMinimallyUnblockedLiteral()
+ * with O(log n) updates per removed occurrence instead of a scan of all variables per root.
+ */
+class PriorityOccurrenceList : public OccurrenceList {
+ public:
+    explicit PriorityOccurrenceList(const CNFFormula& problem_, const OccurrenceIndex* occurrences = nullptr) : OccurrenceList(problem_, occurrences, true) { }
+};
+
 #endif  // SRC_GATES_OCCURRENCELIST_H_
@@ -0,0 +1,102 @@
+/**
+ * MIT License
+ * Copyright (c) 2024 Markus Iser
+ */
+
+#ifndef SRC_EXTRACT_GATES_SEMANTICFILTER_H_
+#define SRC_EXTRACT_GATES_SEMANTICFILTER_H_
+
+#include <cstdint>
+#include <vector>
+
+#include "src/util/SolverTypes.h"
+#include "src/util/OccurrenceIndex.h"
+#include "src/util/Stamp.h"
+
+/**
+ * @brief Cheap tiers of the semantic gate check, which decide if fwd and bwd without the output variable are unsatisfiable
+ * Tiers return ipasir-style results: 20 if the output is defined (unsatisfiable), 10 if not (satisfiable), 0 if undecided.
+ * Only undecided candidates need a SAT call (see SolverPool::check()).
+ */
+class SemanticFilter {
+    std::vector<Var> inputs;  // input variables of the truth table, bit i of an assignment is the value of inputs[i]
+    Stamp<uint32_t> assigned;  // true literals of propagate()
+
+    static constexpr unsigned max_inputs = 6;
+    static constexpr unsigned max_rounds = 8;
+
+    // assignments (bits of a 64-bit truth table) in which the i-th input is true
+    static constexpr uint64_t columns[max_inputs] = {
+        0xAAAAAAAAAAAAAAAAULL, 0xCCCCCCCCCCCCCCCCULL, 0xF0F0F0F0F0F0F0F0ULL,
+        0xFF00FF00FF00FF00ULL, 0xFFFF0000FFFF0000ULL, 0xFFFFFFFF00000000ULL
+    };
+
+ public:
+    explicit SemanticFilter(unsigned nVars) : inputs(), assigned(2 + 2 * nVars) { }
+
+    /**
+     * @brief Exact check by truth table of at most six input variables
+     * @return 0 if there are more inputs
+     */
+    int truthTable(Lit o, ClauseSpan fwd, ClauseSpan bwd) {
+        inputs.clear();
+        uint64_t models = ~0ULL;
+        for (ClauseSpan f : { fwd, bwd }) {
+            for (Cl* cl : f) {
+                uint64_t satisfied = 0;
+                for (Lit lit : *cl) {
+                    if (lit.var() == o.var()) continue;
+                    unsigned i = 0;
+                    while (i < inputs.size() && inputs[i] != lit.var()) ++i;
+                    if (i == inputs.size()) {
+                        if (i == max_inputs) return 0;
+                        inputs.push_back(lit.var());
+                    }
+                    satisfied |= lit.sign() ? ~columns[i] : columns[i];
+                }
+                models &= satisfied;
+            }
+        }
+        if (inputs.size() < max_inputs) models &= (1ULL << (1U << inputs.size())) - 1;
+        return models == 0 ? 20 : 10;
+    }
+
+    /**
+     * @brief Unit propagation for a bounded number of rounds over the clauses
+     * @return 20 on conflict, 10 if the propagated assignment satisfies all clauses, 0 otherwise
+     */
+    int propagate(Lit o, ClauseSpan fwd, ClauseSpan bwd) {
+        assigned.clear();
+        for (unsigned round = 0; round < max_rounds; ++round) {
+            bool changed = false, satisfied = true;
+            for (ClauseSpan f : { fwd, bwd }) {
+                for (Cl* cl : f) {
+                    unsigned n_open = 0;
+                    Lit unit = lit_Undef;
+                    bool sat = false;
+                    for (Lit lit : *cl) {
+                        if (lit.var() == o.var() || assigned[~lit]) continue;
+                        if (assigned[lit]) {
+                            sat = true;
+                            break;
+                        }
+                        ++n_open;
+                        unit = lit;
+                    }
+                    if (sat) continue;
+                    if (n_open == 0) return 20;
+                    satisfied = false;
+                    if (n_open == 1) {
+                        assigned.set(unit);
+                        changed = true;
+                    }
+                }
+            }
+            if (satisfied) return 10;
+            if (!changed) break;
+        }
+        return 0;
+    }
+};
+
+#endif  // SRC_EXTRACT_GATES_SEMANTICFILTER_H_
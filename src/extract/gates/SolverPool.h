@@ -0,0 +1,124 @@
+/**
+ * MIT License
+ * Copyright (c) 2024 Markus Iser
+ */
+
+#ifndef SRC_EXTRACT_GATES_SOLVERPOOL_H_
+#define SRC_EXTRACT_GATES_SOLVERPOOL_H_
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+#include "src/external/ipasir.h"
+
+#include "src/util/SolverTypes.h"
+#include "src/util/OccurrenceIndex.h"
+#include "src/util/ResourceBudget.h"
+
+/**
+ * @brief IPASIR solver instances for semantic gate checks
+ * Each solver is used by one thread at a time, checks on different solvers may run concurrently (see run()).
+ * Checks are interrupted by the terminate callback once the budget is exhausted or the check exceeds its own time limit.
+ */
+class SolverPool {
+    typedef std::chrono::steady_clock clock;
+
+    struct Solver {
+        void* S;
+        int activation;  // last activation variable, above the variables of the formula
+        const ResourceBudget* budget;
+        clock::time_point deadline;  // of the current check
+        bool timed;
+    };
+
+    std::vector<Solver> solvers;  // not resized after construction, the solvers refer to their entries
+    const ResourceBudget* budget_;
+    clock::duration check_limit_;
+
+    static int terminate(void* data) {
+        const Solver* solver = static_cast<const Solver*>(data);
+        if (solver->budget != nullptr && solver->budget->expired()) return 1;
+        return solver->timed && clock::now() > solver->deadline ? 1 : 0;
+    }
+
+ public:
+    /**
+     * @param size number of solvers, at least one
+     * @param nVars number of variables of the formula
+     * @param budget checks are interrupted once the budget is exhausted, may be nullptr
+     * @param check_limit time limit of a single check in seconds, 0 = unlimited
+     */
+    SolverPool(unsigned size, unsigned nVars, const ResourceBudget* budget, double check_limit = 0)
+     : solvers(std::max(1U, size)), budget_(budget),
+       check_limit_(std::chrono::duration_cast<clock::duration>(std::chrono::duration<double>(check_limit))) {
+        for (Solver& solver : solvers) {
+            solver = { ipasir_init(), static_cast<int>(nVars), budget, clock::time_point(), check_limit > 0 };
+            ipasir_set_terminate(solver.S, &solver, terminate);
+        }
+    }
+
+    ~SolverPool() {
+        for (Solver& solver : solvers) ipasir_release(solver.S);
+    }
+
+    SolverPool(const SolverPool&) = delete;
+    SolverPool& operator=(const SolverPool&) = delete;
+
+    inline unsigned size() const {
+        return solvers.size();
+    }
+
+    // true if the budget is exhausted, i.e., interrupted checks were not aborted by their own time limit
+    inline bool expired() const {
+        return budget_ != nullptr && budget_->expired();
+    }
+
+    /**
+     * @brief Checks on the given solver if fwd and bwd without the output variable are unsatisfiable, i.e., o is defined by its inputs
+     * The clauses are guarded by a fresh activation literal which is assumed during the check and retracted
+     * by a unit clause afterwards, such that the solver can discard them and later checks do not slow down.
+     * @return 20 if o is defined, 10 if not, 0 if the check was interrupted (see expired())
+     */
+    int check(unsigned solver, Lit o, ClauseSpan fwd, ClauseSpan bwd) {
+        void* S = solvers[solver].S;
+        int act = ++solvers[solver].activation;
+        solvers[solver].deadline = clock::now() + check_limit_;
+        for (ClauseSpan f : { fwd, bwd }) {
+            for (Cl* cl : f) {
+                for (Lit lit : *cl) {
+                    if (lit.var() != o.var()) ipasir_add(S, lit.toDimacs());
+                }
+                ipasir_add(S, -act);
+                ipasir_add(S, 0);
+            }
+        }
+        ipasir_assume(S, act);
+        int result = ipasir_solve(S);
+        ipasir_add(S, -act);
+        ipasir_add(S, 0);
+        return result;
+    }
+
+    /**
+     * @brief Runs job(i, solver) for all i in [0, n) concurrently on all solvers, the calling thread works with solver 0
+     * Jobs must not throw.
+     */
+    template <typename Job>
+    void run(size_t n, Job job) {
+        std::atomic<size_t> next(0);
+        auto work = [&next, n, &job] (unsigned solver) {
+            for (size_t i = next++; i < n; i = next++) job(i, solver);
+        };
+        std::vector<std::thread> threads;
+        for (unsigned solver = 1; solver < std::min<size_t>(solvers.size(), n); ++solver) {
+            threads.emplace_back(work, solver);
+        }
+        work(0);
+        for (std::thread& thread : threads) thread.join();
+    }
+};
+
+#endif  // SRC_EXTRACT_GATES_SOLVERPOOL_H_
@@ -19,6 +19,7 @@ OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWA
 
 #include <cstdio>
 #include <cstdint>
+#include <cmath>
 #include <string>
 #include <chrono>
 #include <regex>
@@ -28,18 +29,26 @@ OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWA
 #include <future>
 #include <unordered_map>
 #include <variant>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <deque>
+#include <atomic>
 
 #include "src/identify/GBDHash.h"
 #include "src/identify/ISOHash.h"
 
 #include "src/extract/CNFBaseFeatures.h"
 #include "src/extract/CNFGateFeatures.h"
+#include "src/extract/CNFInstance.h"
 #include "src/extract/WCNFBaseFeatures.h"
 #include "src/extract/OPBBaseFeatures.h"
 
 #include "src/transform/IndependentSet.h"
 #include "src/transform/Normalize.h"
-#include "src/util/ResourceLimits.h"
+#include "src/util/ResourceBudget.h"
+#include "src/util/Timer.h"
+#include "src/util/Profile.h"
 
 // #include "src/util/pybind11/include/pybind11/pybind11.h"
 // #include "src/util/pybind11/include/pybind11/stl.h"
@@ -47,6 +56,7 @@ OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWA
 #include "pybind11/pybind11.h"
 #include "pybind11/stl.h"
 #include "pybind11/functional.h"
+#include "pybind11/numpy.h"
 
 namespace py = pybind11;
 
@@ -92,20 +102,104 @@ py::dict cnf2kis(const std::string filename, const std::string output) {
     return dict;
 }
 
-template <typename Extractor>
-py::dict extract_features(const std::string filepath, const size_t rlim, const size_t mlim) {
+/**
+ * @brief CNF instance which is parsed once and shared by all feature extractors and transformers (see CNF::Instance)
+ */
+class Formula {
+    CNF::Instance instance_;
+
+    static py::dict features(IExtractor& stats) {
+        py::dict dict;
+        PhaseTimer timer;
+        {
+            py::gil_scoped_release release;
+            PhaseTimer::Scope scope(timer);
+            stats.extract();
+        }
+        dict[py::str(stats.getRuntimeDesc())] = timer.cpuNs() * 1e-9;
+        const auto names = stats.getNames();
+        const auto features = stats.getFeatures();
+        for (size_t i = 0; i < features.size(); ++i) {
+            dict[py::str(names[i])] = features[i];
+        }
+        return dict;
+    }
+
+ public:
+    explicit Formula(const std::string filename, bool rename) : instance_(filename, rename) { }
+
+    std::string filename() const {
+        return instance_.filename();
+    }
+
+    size_t nVars() const {
+        return instance_.formula().nVars();
+    }
+
+    size_t nClauses() const {
+        return instance_.formula().nClauses();
+    }
+
+    py::dict base_features() const {
+        return features(*instance_.baseFeatures());
+    }
+
+    py::dict gate_features(double check_limit) const {
+        return features(*instance_.gateFeatures(check_limit));
+    }
+
+    std::string isohash() const {
+        return instance_.isohash();
+    }
+
+    py::dict to_kis(const std::string output) const {
+        py::dict dict;
+        std::string hash;
+        unsigned nodes, edges, k;
+        {
+            py::gil_scoped_release release;
+            IndependentSetFromCNF gen(instance_.formula());
+            nodes = gen.numNodes();
+            edges = gen.numEdges();
+            k = gen.minK();
+            gen.generate_independent_set_problem(output.c_str());
+            hash = CNF::gbdhash(output.c_str());
+        }
+        dict[py::str("nodes")] = nodes;
+        dict[py::str("edges")] = edges;
+        dict[py::str("k")] = k;
+        dict[py::str("local")] = output;
+        dict[py::str("hash")] = hash;
+        return dict;
+    }
+};
+
+// wall-clock and cpu seconds of each phase, e.g., base_features_runtime_parse_cpu
+void add_phase_times(py::dict& dict, const std::string& prefix, const PhaseTimer& timer) {
+    for (unsigned p = 0; p < PhaseTimer::N_PHASES; ++p) {
+        std::string name = prefix + "_" + PhaseTimer::names[p];
+        dict[py::str(name + "_wall")] = timer.wallNs(PhaseTimer::Phase(p)) * 1e-9;
+        dict[py::str(name + "_cpu")] = timer.cpuNs(PhaseTimer::Phase(p)) * 1e-9;
+    }
+}
+
+py::dict extract_features(IExtractor& stats, const size_t rlim, const size_t mlim, const bool timings) {
     py::dict dict;
-    Extractor stats(filepath.c_str());
-    ResourceLimits limits(rlim, mlim);
-    limits.set_rlimits();
+    ResourceBudget budget(rlim, mlim);
+    PhaseTimer timer;
     try {
-        stats.extract();
-        dict[py::str(stats.getRuntimeDesc())] = (double)limits.get_runtime();
+        {
+            py::gil_scoped_release release;
+            PhaseTimer::Scope scope(timer);
+            stats.extractWithin(budget);
+        }
+        dict[py::str(stats.getRuntimeDesc())] = timer.cpuNs() * 1e-9;
         const auto names = stats.getNames();
         const auto features = stats.getFeatures();
         for (size_t i = 0; i < features.size(); ++i) {
             dict[py::str(names[i])] = features[i];
         }
+        if (timings) add_phase_times(dict, stats.getRuntimeDesc(), timer);
     }
     catch (TimeLimitExceeded &e) {
         dict[py::str(stats.getRuntimeDesc())] = "timeout";
@@ -113,26 +207,369 @@ py::dict extract_features(const std::string filepath, const size_t rlim, const s
     catch (MemoryLimitExceeded &e) {
         dict[py::str(stats.getRuntimeDesc())] = "memout";
     }
+    catch (std::bad_alloc &e) {
+        dict[py::str(stats.getRuntimeDesc())] = "memout";
+    }
+    return dict;
+}
+
+template <typename Extractor>
+py::dict extract_features(const std::string filepath, const size_t rlim, const size_t mlim, const bool timings) {
+    Extractor stats(filepath.c_str());
+    return extract_features(stats, rlim, mlim, timings);
+}
+
+py::dict extract_gate_features(const std::string filepath, const size_t rlim, const size_t mlim, const bool timings, const bool rename, const double check_limit) {
+    CNF::GateFeatures stats(filepath.c_str(), check_limit, rename);
+    return extract_features(stats, rlim, mlim, timings);
+}
+
+// check_limit is the time limit of a single semantic check of the gate extractor (0 = unlimited)
+std::unique_ptr<IExtractor> make_extractor(const std::string& name, const char* filepath, double check_limit = 0) {
+    if (name == "base") return std::unique_ptr<IExtractor>(new CNF::BaseFeatures(filepath));
+    if (name == "gate") return std::unique_ptr<IExtractor>(new CNF::GateFeatures(filepath, check_limit));
+    if (name == "wcnf_base") return std::unique_ptr<IExtractor>(new WCNF::BaseFeatures(filepath));
+    if (name == "opb_base") return std::unique_ptr<IExtractor>(new OPB::BaseFeatures(filepath));
+    throw std::invalid_argument("Unknown extractor: " + name);
+}
+
+/**
+ * @brief Extraction result without Python objects, such that it can be computed without holding the GIL
+ */
+struct Extraction {
+    std::string runtime_desc;  // empty if the extractor could not be created
+    std::vector<std::string> names;
+    std::vector<double> features;
+    double runtime = 0;  // cpu seconds
+    std::string status;  // empty on success, otherwise "timeout", "memout" or error message
+};
+
+// runs the extractor within the given budget, exceeded limits and errors are reported in the status of the result
+Extraction run_extraction(const std::string& extractor, const std::string& filepath, ResourceBudget& budget, double check_limit) {
+    Extraction result;
+    try {
+        std::unique_ptr<IExtractor> stats = make_extractor(extractor, filepath.c_str(), check_limit);
+        result.runtime_desc = stats->getRuntimeDesc();
+        PhaseTimer timer;
+        {
+            PhaseTimer::Scope scope(timer);
+            stats->extractWithin(budget);
+        }
+        result.runtime = timer.cpuNs() * 1e-9;
+        result.names = stats->getNames();
+        result.features = stats->getFeatures();
+    }
+    catch (TimeLimitExceeded& e) {
+        result.status = "timeout";
+    }
+    catch (MemoryLimitExceeded& e) {
+        result.status = "memout";
+    }
+    catch (std::bad_alloc& e) {
+        result.status = "memout";
+    }
+    catch (std::exception& e) {
+        result.status = e.what();
+    }
+    return result;
+}
+
+/**
+ * @brief Runs feature extractors for many instances on a pool of native threads
+ * Workers never touch Python objects, results are converted when they are consumed by the Python iterator.
+ * Each job runs within its own ResourceBudget.
+ */
+class BatchExtraction {
+    struct Job {
+        std::string path;
+        std::string extractor;
+    };
+
+    struct Result {
+        const Job* job;
+        Extraction extraction;
+    };
+
+    std::vector<Job> jobs;
+    unsigned rlim_, mlim_;
+    double check_limit_;
+
+    std::atomic<size_t> next;
+    std::atomic<bool> cancelled;
+    std::mutex mutex;
+    std::condition_variable available;
+    std::deque<Result> results;
+    size_t delivered;
+    std::vector<ResourceBudget*> running;  // budget of the current job of each worker, guarded by mutex
+    std::vector<std::thread> workers;
+
+    void work(unsigned worker) {
+        size_t i;
+        while (!cancelled && (i = next++) < jobs.size()) {
+            ResourceBudget budget(rlim_, mlim_);
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                running[worker] = &budget;
+            }
+            Result result { &jobs[i], run_extraction(jobs[i].extractor, jobs[i].path, budget, check_limit_) };
+            std::lock_guard<std::mutex> lock(mutex);
+            running[worker] = nullptr;
+            results.push_back(std::move(result));
+            available.notify_one();
+        }
+    }
+
+ public:
+    BatchExtraction(const std::vector<std::string>& paths, const std::vector<std::string>& extractors, unsigned threads, unsigned rlim, unsigned mlim, double check_limit)
+     : jobs(), rlim_(rlim), mlim_(mlim), check_limit_(check_limit), next(0), cancelled(false), delivered(0) {
+        for (const std::string& extractor : extractors) {
+            make_extractor(extractor, "");  // throws on unknown extractor
+        }
+        for (const std::string& path : paths) {
+            for (const std::string& extractor : extractors) {
+                jobs.push_back({ path, extractor });
+            }
+        }
+        if (threads == 0) threads = std::max(1U, std::thread::hardware_concurrency());
+        threads = std::min<size_t>(threads, std::max<size_t>(1, jobs.size()));
+        running.resize(threads, nullptr);
+        for (unsigned t = 0; t < threads; ++t) {
+            workers.emplace_back(&BatchExtraction::work, this, t);
+        }
+    }
+
+    ~BatchExtraction() {
+        cancelled = true;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            for (ResourceBudget* budget : running) {
+                if (budget != nullptr) budget->cancel();
+            }
+        }
+        for (std::thread& worker : workers) {
+            worker.join();
+        }
+    }
+
+    // (path, extractor, features) of the next completed job
+    py::tuple next_result() {
+        if (delivered == jobs.size()) {
+            throw py::stop_iteration();
+        }
+        Result result;
+        {
+            py::gil_scoped_release release;
+            std::unique_lock<std::mutex> lock(mutex);
+            available.wait(lock, [this] { return !results.empty(); });
+            result = std::move(results.front());
+            results.pop_front();
+        }
+        ++delivered;
+        const Extraction& extraction = result.extraction;
+        py::dict dict;
+        if (extraction.status.empty()) {
+            dict[py::str(extraction.runtime_desc)] = extraction.runtime;
+            for (size_t i = 0; i < extraction.features.size(); ++i) {
+                dict[py::str(extraction.names[i])] = extraction.features[i];
+            }
+        } else {
+            dict[py::str(extraction.runtime_desc.empty() ? "error" : extraction.runtime_desc)] = extraction.status;
+        }
+        return py::make_tuple(result.job->path, result.job->extractor, dict);
+    }
+};
+
+// feature names of the given extractor as a tuple which is created once and shared by all callers
+py::tuple cached_feature_names(const std::string& extractor) {
+    // never destroyed, as the tuples must not be released after interpreter shutdown
+    static std::unordered_map<std::string, py::tuple>* cache = new std::unordered_map<std::string, py::tuple>();
+    auto it = cache->find(extractor);
+    if (it == cache->end()) {
+        std::vector<std::string> names = make_extractor(extractor, "")->getNames();
+        py::tuple tuple(names.size());
+        for (size_t i = 0; i < names.size(); ++i) {
+            tuple[i] = py::str(names[i]);
+        }
+        it = cache->emplace(extractor, tuple).first;
+    }
+    return it->second;
+}
+
+py::object runtime_or_status(const Extraction& result) {
+    if (!result.status.empty()) return py::str(result.status);
+    return py::float_(result.runtime);
+}
+
+/**
+ * @brief Features as a float64 array which takes ownership of the extracted vector (no copy)
+ * @return (features, runtime) where runtime is "timeout", "memout" or an error message and features are NaN on failure
+ */
+py::tuple extract_features_array(const std::string filepath, const std::string extractor, unsigned rlim, unsigned mlim, double check_limit) {
+    size_t size = make_extractor(extractor, "")->getNames().size();
+    Extraction result;
+    {
+        py::gil_scoped_release release;
+        ResourceBudget budget(rlim, mlim);
+        result = run_extraction(extractor, filepath, budget, check_limit);
+    }
+    if (!result.status.empty()) {
+        result.features.assign(size, std::nan(""));
+    }
+    std::vector<double>* features = new std::vector<double>(std::move(result.features));
+    py::capsule owner(features, [] (void* data) { delete static_cast<std::vector<double>*>(data); });
+    py::array_t<double> array(features->size(), features->data(), owner);
+    return py::make_tuple(array, runtime_or_status(result));
+}
+
+/**
+ * @brief Fill row i of the preallocated C-contiguous 2-D float64 array with the features of paths[i]
+ * Rows are filled by parallel native threads without holding the GIL. Rows of failed extractions are NaN.
+ * @return runtime or "timeout", "memout" or error message for each row
+ */
+py::list extract_features_into(const std::vector<std::string>& paths, const std::string extractor,
+        py::array_t<double, py::array::c_style> out, unsigned threads, unsigned rlim, unsigned mlim, double check_limit) {
+    size_t columns = make_extractor(extractor, "")->getNames().size();
+    if (out.ndim() != 2 || static_cast<size_t>(out.shape(0)) != paths.size() || static_cast<size_t>(out.shape(1)) != columns) {
+        throw std::invalid_argument("Expected array of shape (" + std::to_string(paths.size()) + ", " + std::to_string(columns) + ")");
+    }
+    double* data = out.mutable_data();
+    std::vector<Extraction> results(paths.size());
+    {
+        py::gil_scoped_release release;
+        std::atomic<size_t> next(0);
+        auto work = [&] () {
+            for (size_t i = next++; i < paths.size(); i = next++) {
+                ResourceBudget budget(rlim, mlim);
+                results[i] = run_extraction(extractor, paths[i], budget, check_limit);
+                double* row = data + i * columns;
+                if (results[i].status.empty()) {
+                    std::copy(results[i].features.begin(), results[i].features.end(), row);
+                } else {
+                    std::fill(row, row + columns, std::nan(""));
+                }
+                std::vector<double>().swap(results[i].features);
+                std::vector<std::string>().swap(results[i].names);
+            }
+        };
+        if (threads == 0) threads = std::max(1U, std::thread::hardware_concurrency());
+        threads = std::min<size_t>(threads, std::max<size_t>(1, paths.size()));
+        std::vector<std::thread> workers;
+        for (unsigned t = 1; t < threads; ++t) {
+            workers.emplace_back(work);
+        }
+        work();
+        for (std::thread& worker : workers) {
+            worker.join();
+        }
+    }
+    py::list runtimes;
+    for (const Extraction& result : results) {
+        runtimes.append(runtime_or_status(result));
+    }
+    return runtimes;
+}
+
+/**
+ * @brief Profile of running the given tool (an extractor, gbdhash or isohash) on the given file
+ * Counters are only collected in builds with GBDC_PROFILE.
+ */
+py::dict profile_tool(const std::string filepath, const std::string tool, unsigned rlim, unsigned mlim, double check_limit) {
+    Profile profile;
+    std::string status = "ok";
+    {
+        py::gil_scoped_release release;
+        ResourceBudget budget(rlim, mlim);
+        ResourceBudget::Scope budget_scope(budget);
+        Profile::Scope profile_scope(profile);
+        try {
+            if (tool == "gbdhash") {
+                CNF::gbdhash(filepath.c_str());
+            } else if (tool == "isohash") {
+                CNF::isohash(filepath.c_str());
+            } else {
+                make_extractor(tool, filepath.c_str(), check_limit)->extract();
+            }
+        }
+        catch (TimeLimitExceeded& e) {
+            status = "timeout";
+        }
+        catch (MemoryLimitExceeded& e) {
+            status = "memout";
+        }
+    }
+    py::dict dict, phases, counters;
+    for (unsigned p = 0; p < PhaseTimer::N_PHASES; ++p) {
+        PhaseTimer::Phase phase = PhaseTimer::Phase(p);
+        py::dict entry;
+        entry[py::str("wall_ns")] = profile.timer().wallNs(phase);
+        entry[py::str("cpu_ns")] = profile.timer().cpuNs(phase);
+        entry[py::str("peak_bytes")] = profile.timer().peakBytes(phase);
+        phases[py::str(PhaseTimer::names[p])] = entry;
+    }
+    for (unsigned c = 0; c < Profile::N_COUNTERS; ++c) {
+        counters[py::str(Profile::counter_names[c])] = profile.counter(Profile::Counter(c));
+    }
+    dict[py::str("status")] = status;
+    dict[py::str("phases")] = phases;
+    dict[py::str("wall_ns")] = profile.timer().wallNs();
+    dict[py::str("cpu_ns")] = profile.timer().cpuNs();
+    dict[py::str("counters_enabled")] = Profile::counters_enabled;
+    dict[py::str("counters")] = counters;
     return dict;
 }
 
 PYBIND11_MODULE(gbdc, m) {
     m.doc() = "GBDC Python Bindings";
-    m.def("extract_base_features", &extract_features<CNF::BaseFeatures>, "Extract cnf base features", py::arg("filepath"), py::arg("rlim"), py::arg("mlim"));
-    m.def("extract_gate_features", &extract_features<CNF::GateFeatures>, "Extract cnf gate features", py::arg("filepath"), py::arg("rlim"), py::arg("mlim"));
-    m.def("extract_wcnf_base_features", &extract_features<WCNF::BaseFeatures>, "Extract wcnf base features", py::arg("filepath"), py::arg("rlim"), py::arg("mlim"));
-    m.def("extract_opb_base_features", &extract_features<OPB::BaseFeatures>, "Extract opb base features", py::arg("filepath"), py::arg("rlim"), py::arg("mlim"));
+    m.def("extract_base_features", &extract_features<CNF::BaseFeatures>, "Extract cnf base features. The time limit (seconds) is wall-clock time, the memory limit (mega bytes) bounds the accounted memory: clauses, occurrence indexes and the per-variable and distribution vectors of the extractors.", py::arg("filepath"), py::arg("rlim"), py::arg("mlim"), py::arg("timings") = false);
+    m.def("extract_gate_features", &extract_gate_features, "Extract cnf gate features. The time limit (seconds) is wall-clock time, the memory limit (mega bytes) bounds the accounted memory: clauses, occurrence indexes and the per-variable and distribution vectors of the extractors. "
+        "With rename, variables are renamed to 1..n in order of first occurrence, such that sparse variable ids do not size the analysis."
+        " The check limit (seconds) bounds each semantic check of the gate extractor, 0 = unlimited.", py::arg("filepath"), py::arg("rlim"), py::arg("mlim"), py::arg("timings") = false, py::arg("rename") = false, py::arg("check_limit") = 0.0);
+    m.def("extract_wcnf_base_features", &extract_features<WCNF::BaseFeatures>, "Extract wcnf base features. The time limit (seconds) is wall-clock time, the memory limit (mega bytes) bounds the accounted memory: clauses, occurrence indexes and the per-variable and distribution vectors of the extractors.", py::arg("filepath"), py::arg("rlim"), py::arg("mlim"), py::arg("timings") = false);
+    m.def("extract_opb_base_features", &extract_features<OPB::BaseFeatures>, "Extract opb base features. The time limit (seconds) is wall-clock time, the memory limit (mega bytes) bounds the accounted memory: clauses, occurrence indexes and the per-variable and distribution vectors of the extractors.", py::arg("filepath"), py::arg("rlim"), py::arg("mlim"), py::arg("timings") = false);
     m.def("version", &version, "Return current version of gbdc.");
-    m.def("cnf2kis", &cnf2kis, "Create k-ISP Instance from given CNF Instance.", py::arg("filename"), py::arg("output"));
-    m.def("sanitize", &sanitize, "Print sanitized, i.e., no duplicate literals in clauses and no tautologic clauses, CNF to stdout.", py::arg("filename"));
+    m.def("cnf2kis", &cnf2kis, "Create k-ISP Instance from given CNF Instance.", py::arg("filename"), py::arg("output"), py::call_guard<py::gil_scoped_release>());
+    m.def("sanitize", &sanitize, "Print sanitized, i.e., no duplicate literals in clauses and no tautologic clauses, CNF to stdout.", py::arg("filename"), py::call_guard<py::gil_scoped_release>());
     m.def("base_feature_names", &feature_names<CNF::BaseFeatures>, "Get Base Feature Names");
     m.def("gate_feature_names", &feature_names<CNF::GateFeatures>, "Get Gate Feature Names");
     m.def("wcnf_base_feature_names", &feature_names<WCNF::BaseFeatures>, "Get WCNF Base Feature Names");
     m.def("opb_base_feature_names", &feature_names<OPB::BaseFeatures>, "Get OPB Base Feature Names");
-    m.def("gbdhash", &CNF::gbdhash, "Calculates GBD-Hash (md5 of normalized file) of given DIMACS CNF file.", py::arg("filename"));
-    m.def("isohash", &CNF::isohash, "Calculates ISO-Hash (md5 of sorted degree sequence) of given DIMACS CNF file.", py::arg("filename"));
-    m.def("opbhash", &OPB::gbdhash, "Calculates OPB-Hash (md5 of normalized file) of given OPB file.", py::arg("filename"));
-    m.def("pqbfhash", &PQBF::gbdhash, "Calculates PQBF-Hash (md5 of normalized file) of given PQBF file.", py::arg("filename"));
-    m.def("wcnfhash", &WCNF::gbdhash, "Calculates WCNF-Hash (md5 of normalized file) of given WCNF file.", py::arg("filename"));
-    m.def("wcnfisohash", &WCNF::isohash, "Calculates WCNF ISO-Hash of given WCNF file.", py::arg("filename"));
+    m.def("gbdhash", &CNF::gbdhash, "Calculates GBD-Hash (md5 of normalized file) of given DIMACS CNF file.", py::arg("filename"), py::call_guard<py::gil_scoped_release>());
+    m.def("isohash", static_cast<std::string (*)(const char*)>(&CNF::isohash), "Calculates ISO-Hash (md5 of sorted degree sequence) of given DIMACS CNF file.", py::arg("filename"), py::call_guard<py::gil_scoped_release>());
+    m.def("opbhash", &OPB::gbdhash, "Calculates OPB-Hash (md5 of normalized file) of given OPB file.", py::arg("filename"), py::call_guard<py::gil_scoped_release>());
+    m.def("pqbfhash", &PQBF::gbdhash, "Calculates PQBF-Hash (md5 of normalized file) of given PQBF file.", py::arg("filename"), py::call_guard<py::gil_scoped_release>());
+    m.def("wcnfhash", &WCNF::gbdhash, "Calculates WCNF-Hash (md5 of normalized file) of given WCNF file.", py::arg("filename"), py::call_guard<py::gil_scoped_release>());
+    m.def("wcnfisohash", &WCNF::isohash, "Calculates WCNF ISO-Hash of given WCNF file.", py::arg("filename"), py::call_guard<py::gil_scoped_release>());
+    m.def("extract_many", [] (const std::vector<std::string>& paths, const std::vector<std::string>& extractors, unsigned threads, size_t rlim, size_t mlim, double check_limit) {
+            return std::unique_ptr<BatchExtraction>(new BatchExtraction(paths, extractors, threads, rlim, mlim, check_limit));
+        }, "Extract features of many instances in parallel native threads. Extractors: base, gate, wcnf_base, opb_base. "
+        "Returns an iterator over (path, extractor, features) tuples in order of completion. "
+        "Limits apply to each job. The time limit (seconds) is wall-clock time, the memory limit (mega bytes) bounds the accounted memory: clauses, occurrence indexes and the per-variable and distribution vectors of the extractors. The check limit (seconds) bounds each semantic check of the gate extractor, 0 = unlimited.",
+        py::arg("paths"), py::arg("extractors"), py::arg("threads") = 0, py::arg("rlim") = 0, py::arg("mlim") = 0, py::arg("check_limit") = 0.0);
+    m.def("feature_names", &cached_feature_names, "Feature names of the given extractor (base, gate, wcnf_base, opb_base) "
+        "in the column order of extract_features_array() and extract_features_into(). The tuple is shared between calls.",
+        py::arg("extractor"));
+    m.def("extract_features_array", &extract_features_array, "Extract features of the given extractor as a float64 array. "
+        "Returns (features, runtime), where runtime is 'timeout' or 'memout' and features are NaN if a limit was exceeded. "
+        "The time limit (seconds) is wall-clock time, the memory limit (mega bytes) bounds the accounted memory: clauses, occurrence indexes and the per-variable and distribution vectors of the extractors. The check limit (seconds) bounds each semantic check of the gate extractor, 0 = unlimited.",
+        py::arg("filepath"), py::arg("extractor"), py::arg("rlim") = 0, py::arg("mlim") = 0, py::arg("check_limit") = 0.0);
+    m.def("extract_features_into", &extract_features_into, "Extract features of all paths in parallel native threads "
+        "into the rows of a preallocated C-contiguous float64 array of shape (len(paths), len(feature_names(extractor))). "
+        "Returns the runtime or 'timeout'/'memout' of each row. The time limit (seconds) is wall-clock time, the memory limit (mega bytes) bounds the accounted memory: clauses, occurrence indexes and the per-variable and distribution vectors of the extractors. The check limit (seconds) bounds each semantic check of the gate extractor, 0 = unlimited.",
+        py::arg("paths"), py::arg("extractor"), py::arg("out").noconvert(), py::arg("threads") = 0, py::arg("rlim") = 0, py::arg("mlim") = 0, py::arg("check_limit") = 0.0);
+    m.def("profile", &profile_tool, "Profile the given tool (base, gate, wcnf_base, opb_base, gbdhash, isohash) on the given file. "
+        "Returns a dict with wall-clock and cpu time and peak accounted memory per phase, and event counters (only in builds with GBDC_PROFILE).",
+        py::arg("filepath"), py::arg("tool") = "base", py::arg("rlim") = 0, py::arg("mlim") = 0, py::arg("check_limit") = 0.0);
+    py::class_<BatchExtraction>(m, "BatchExtraction", "Iterator over results of extract_many()")
+        .def("__iter__", [] (BatchExtraction& self) -> BatchExtraction& { return self; }, py::return_value_policy::reference_internal)
+        .def("__next__", &BatchExtraction::next_result);
+    py::class_<Formula>(m, "Formula", "CNF instance which is parsed once for several extractors and transformers.")
+        .def(py::init<const std::string, bool>(), "Parse given DIMACS CNF file. With rename, variables of the formula are renamed to 1..n in order of first occurrence.",
+            py::arg("filename"), py::arg("rename") = false, py::call_guard<py::gil_scoped_release>())
+        .def_property_readonly("filename", &Formula::filename)
+        .def_property_readonly("variables", &Formula::nVars, "Number of variables of the sanitized formula")
+        .def_property_readonly("clauses", &Formula::nClauses, "Number of clauses of the sanitized formula")
+        .def("base_features", &Formula::base_features, "Extract cnf base features of the file, equal to extract_base_features(filename)")
+        .def("gate_features", &Formula::gate_features, "Extract cnf gate features of the loaded formula. The check limit (seconds) bounds each semantic check of the gate extractor, 0 = unlimited.", py::arg("check_limit") = 0.0)
+        .def("isohash", &Formula::isohash, "Calculates ISO-Hash of the file, equal to isohash(filename).", py::call_guard<py::gil_scoped_release>())
+        .def("to_kis", &Formula::to_kis, "Create k-ISP Instance from the loaded formula.", py::arg("output"));
 }
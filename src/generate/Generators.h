@@ -0,0 +1,358 @@
+/**
+ * MIT License
+ * Copyright (c) 2024 Markus Iser
+ */
+
+#ifndef SRC_GENERATE_GENERATORS_H_
+#define SRC_GENERATE_GENERATORS_H_
+
+#include <algorithm>
+#include <cstdint>
+#include <initializer_list>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "src/util/SolverTypes.h"
+#include "src/generate/InstanceWriter.h"
+
+/**
+ * Deterministic generators of synthetic instances for scaling benchmarks.
+ * Output depends only on the parameters and the seed (no std:: distributions, which differ between standard libraries).
+ * Instances are streamed to the writer, memory is independent of the number of clauses.
+ */
+namespace generate {
+
+// splitmix64
+class Random {
+    uint64_t state;
+
+ public:
+    explicit Random(uint64_t seed) : state(seed) { }
+
+    inline uint64_t next() {
+        uint64_t z = (state += 0x9E3779B97F4A7C15ULL);
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+        return z ^ (z >> 31);
+    }
+
+    // in [0, n), n > 0 (modulo bias is negligible for the sizes used here)
+    inline uint64_t below(uint64_t n) {
+        return next() % n;
+    }
+
+    // true with probability p
+    inline bool chance(double p) {
+        return (next() >> 11) * 0x1.0p-53 < p;
+    }
+
+    inline bool sign() {
+        return next() >> 63;
+    }
+};
+
+// k distinct variables, drawn by select(), with random signs
+template <typename Select>
+inline void random_clause(Random& rng, unsigned k, std::vector<Lit>& clause, Select select) {
+    clause.clear();
+    while (clause.size() < k) {
+        Lit lit(Var(select()), rng.sign());
+        if (std::none_of(clause.begin(), clause.end(), [lit] (Lit other) { return other.var() == lit.var(); })) {
+            clause.push_back(lit);
+        }
+    }
+}
+
+/**
+ * @brief Uniform random k-CNF
+ */
+class RandomKCNF {
+    unsigned nVars, k;
+    uint64_t nClauses, seed;
+
+ public:
+    RandomKCNF(unsigned nVars, uint64_t nClauses, unsigned k, uint64_t seed) : nVars(nVars), k(k), nClauses(nClauses), seed(seed) {
+        if (k == 0 || k > nVars) throw std::invalid_argument("Clause length must be in [1, variables]");
+    }
+
+    void write(InstanceWriter& out) const {
+        Random rng(seed);
+        std::vector<Lit> clause;
+        out << "p cnf " << nVars << ' ' << nClauses << '\n';
+        for (uint64_t i = 0; i < nClauses; ++i) {
+            random_clause(rng, k, clause, [&] () { return 1 + rng.below(nVars); });
+            out.clause(clause);
+        }
+    }
+};
+
+/**
+ * @brief Community-structured random k-CNF (as in industrial instances)
+ * Variables are partitioned into equally sized communities. Each clause belongs to a random community,
+ * each of its literals is drawn from that community with probability modularity and from all variables otherwise.
+ */
+class CommunityCNF {
+    unsigned nVars, k, nCommunities;
+    uint64_t nClauses, seed;
+    double modularity;
+
+ public:
+    CommunityCNF(unsigned nVars, uint64_t nClauses, unsigned k, unsigned nCommunities, double modularity, uint64_t seed)
+     : nVars(nVars), k(k), nCommunities(nCommunities), nClauses(nClauses), seed(seed), modularity(modularity) {
+        if (nCommunities == 0 || nCommunities > nVars) throw std::invalid_argument("Communities must be in [1, variables]");
+        if (k == 0 || k > nVars / nCommunities) throw std::invalid_argument("Clause length must be in [1, community size]");
+    }
+
+    void write(InstanceWriter& out) const {
+        Random rng(seed);
+        std::vector<Lit> clause;
+        unsigned size = nVars / nCommunities;
+        out << "p cnf " << nVars << ' ' << nClauses << '\n';
+        for (uint64_t i = 0; i < nClauses; ++i) {
+            unsigned first = 1 + rng.below(nCommunities) * size;
+            random_clause(rng, k, clause, [&] () {
+                return rng.chance(modularity) ? first + rng.below(size) : 1 + rng.below(nVars);
+            });
+            out.clause(clause);
+        }
+    }
+};
+
+/**
+ * @brief Tseitin encoding of a random circuit of binary AND, OR and XOR gates and multiplexers
+ * Gate i defines variable nInputs + i + 1 over two signed operands (and a selector for multiplexers), chosen among the preceding
+ * window variables (inputs or gate outputs). Outputs without fanout are asserted by unit clauses,
+ * such that GateAnalyzer finds the circuit from these roots.
+ * Multiplexers match none of GateAnalyzer's clause patterns, they are recognized by semantic checks.
+ * Wide multiplexers o = s ? (a & a2 & a3) : (b & b2 & b3) have seven inputs, which are too many for truth tables,
+ * such that each is recognized by propagation or a SAT call.
+ */
+class TseitinCircuit {
+    unsigned nInputs, nGates, window;
+    double xorRatio, orRatio, muxRatio, wideMuxRatio;
+    uint64_t seed;
+
+    enum Type { AND, OR, XOR, MUX, WIDE_MUX };
+
+    struct Gate {
+        Type type;
+        Lit out, a, b, s;
+        Lit a2, a3, b2, b3;  // further operands of wide multiplexers
+    };
+
+    // variable in [lo, out) which is not among the given ones
+    inline unsigned distinct(Random& rng, unsigned lo, unsigned out, std::initializer_list<unsigned> taken) const {
+        unsigned v;
+        do v = lo + rng.below(out - lo); while (std::find(taken.begin(), taken.end(), v) != taken.end());
+        return v;
+    }
+
+    // the i-th gate, drawn from rng
+    inline Gate gate(Random& rng, unsigned i) const {
+        unsigned out = nInputs + i + 1;
+        unsigned lo = out > window ? out - window : 1;
+        unsigned a = lo + rng.below(out - lo);
+        unsigned b = lo + rng.below(out - lo - 1);
+        if (b >= a) ++b;
+        // no draw for (wide) multiplexers if disabled, such that circuits without them are the same as before their introduction
+        Type type = wideMuxRatio > 0 && rng.chance(wideMuxRatio) ? WIDE_MUX : muxRatio > 0 && rng.chance(muxRatio) ? MUX
+            : rng.chance(xorRatio) ? XOR : rng.chance(orRatio) ? OR : AND;
+        unsigned s = 0;
+        if (type == MUX) {
+            if (out - lo < 3) type = AND;  // no room for a selector
+            else s = distinct(rng, lo, out, { a, b });
+        }
+        if (type == WIDE_MUX) {
+            if (out - lo < 7) type = AND;  // no room for seven inputs
+            else s = distinct(rng, lo, out, { a, b });
+        }
+        Gate g { type, Lit(Var(out), false), Lit(Var(a), rng.sign()), Lit(Var(b), rng.sign()), Lit(Var(s), false), lit_Undef, lit_Undef, lit_Undef, lit_Undef };
+        if (type == WIDE_MUX) {
+            unsigned a2 = distinct(rng, lo, out, { a, b, s });
+            unsigned a3 = distinct(rng, lo, out, { a, b, s, a2 });
+            unsigned b2 = distinct(rng, lo, out, { a, b, s, a2, a3 });
+            unsigned b3 = distinct(rng, lo, out, { a, b, s, a2, a3, b2 });
+            g.a2 = Lit(Var(a2), rng.sign());
+            g.a3 = Lit(Var(a3), rng.sign());
+            g.b2 = Lit(Var(b2), rng.sign());
+            g.b3 = Lit(Var(b3), rng.sign());
+        }
+        return g;
+    }
+
+ public:
+    TseitinCircuit(unsigned nInputs, unsigned nGates, double xorRatio, double orRatio, double muxRatio, double wideMuxRatio, unsigned window, uint64_t seed)
+     : nInputs(nInputs), nGates(nGates), window(window), xorRatio(xorRatio), orRatio(orRatio), muxRatio(muxRatio), wideMuxRatio(wideMuxRatio), seed(seed) {
+        if (nInputs < 2) throw std::invalid_argument("Circuit needs at least two inputs");
+        if (window < 2) throw std::invalid_argument("Window must be at least two");
+    }
+
+    // two passes with the same seed: the first determines the outputs and the exact header
+    void write(InstanceWriter& out) const {
+        unsigned nVars = nInputs + nGates;
+        std::vector<bool> fanout(nVars + 1, false);
+        uint64_t nClauses = 0;
+        Random rng(seed);
+        for (unsigned i = 0; i < nGates; ++i) {
+            Gate g = gate(rng, i);
+            fanout[g.a.var()] = fanout[g.b.var()] = fanout[g.s.var()] = true;
+            if (g.type == WIDE_MUX) fanout[g.a2.var()] = fanout[g.a3.var()] = fanout[g.b2.var()] = fanout[g.b3.var()] = true;
+            nClauses += g.type == WIDE_MUX ? 8 : g.type == XOR || g.type == MUX ? 4 : 3;
+        }
+        for (unsigned v = nInputs + 1; v <= nVars; ++v) {
+            if (!fanout[v]) ++nClauses;
+        }
+
+        out << "p cnf " << nVars << ' ' << nClauses << '\n';
+        rng = Random(seed);
+        for (unsigned i = 0; i < nGates; ++i) {
+            Gate g = gate(rng, i);
+            Lit o = g.out, a = g.a, b = g.b, s = g.s;
+            switch (g.type) {
+            case AND:
+                out.clause({ ~o, a });
+                out.clause({ ~o, b });
+                out.clause({ o, ~a, ~b });
+                break;
+            case OR:
+                out.clause({ o, ~a });
+                out.clause({ o, ~b });
+                out.clause({ ~o, a, b });
+                break;
+            case XOR:
+                out.clause({ ~o, a, b });
+                out.clause({ ~o, ~a, ~b });
+                out.clause({ o, ~a, b });
+                out.clause({ o, a, ~b });
+                break;
+            case MUX:  // o = s ? a : b
+                out.clause({ ~o, ~s, a });
+                out.clause({ ~o, s, b });
+                out.clause({ o, ~s, ~a });
+                out.clause({ o, s, ~b });
+                break;
+            case WIDE_MUX:  // o = s ? (a & a2 & a3) : (b & b2 & b3)
+                for (Lit x : { a, g.a2, g.a3 }) out.clause({ ~o, ~s, x });
+                for (Lit y : { b, g.b2, g.b3 }) out.clause({ ~o, s, y });
+                out.clause({ o, ~s, ~a, ~g.a2, ~g.a3 });
+                out.clause({ o, s, ~b, ~g.b2, ~g.b3 });
+                break;
+            }
+        }
+        for (unsigned v = nInputs + 1; v <= nVars; ++v) {
+            if (!fanout[v]) out.clause({ Lit(Var(v), false) });
+        }
+    }
+};
+
+/**
+ * @brief Random weighted MaxSAT instance (new WCNF format without header)
+ * Hard clauses are random k-CNF, soft clauses are random unit clauses with weights in [1, maxWeight].
+ */
+class RandomWCNF {
+    unsigned nVars, k;
+    uint64_t nHard, nSoft, maxWeight, seed;
+
+ public:
+    RandomWCNF(unsigned nVars, uint64_t nHard, uint64_t nSoft, unsigned k, uint64_t maxWeight, uint64_t seed)
+     : nVars(nVars), k(k), nHard(nHard), nSoft(nSoft), maxWeight(maxWeight), seed(seed) {
+        if (k == 0 || k > nVars) throw std::invalid_argument("Clause length must be in [1, variables]");
+        if (maxWeight == 0) throw std::invalid_argument("Maximum weight must be positive");
+    }
+
+    void write(InstanceWriter& out) const {
+        Random rng(seed);
+        std::vector<Lit> clause;
+        for (uint64_t i = 0; i < nHard; ++i) {
+            random_clause(rng, k, clause, [&] () { return 1 + rng.below(nVars); });
+            out << "h ";
+            out.clause(clause);
+        }
+        for (uint64_t i = 0; i < nSoft; ++i) {
+            out << 1 + rng.below(maxWeight) << ' ' << Lit(Var(1 + rng.below(nVars)), rng.sign()) << " 0\n";
+        }
+    }
+};
+
+/**
+ * @brief Random pseudo-Boolean optimization instance (OPB format)
+ * Constraints have k terms over random literals with coefficients in [1, maxCoeff],
+ * the degree is half the sum of the coefficients.
+ * The objective minimizes the sum of all variables.
+ */
+class RandomOPB {
+    unsigned nVars, k;
+    uint64_t nConstraints, maxCoeff, seed;
+
+ public:
+    RandomOPB(unsigned nVars, uint64_t nConstraints, unsigned k, uint64_t maxCoeff, uint64_t seed)
+     : nVars(nVars), k(k), nConstraints(nConstraints), maxCoeff(maxCoeff), seed(seed) {
+        if (k == 0 || k > nVars) throw std::invalid_argument("Constraint length must be in [1, variables]");
+        if (maxCoeff == 0) throw std::invalid_argument("Maximum coefficient must be positive");
+    }
+
+    void write(InstanceWriter& out) const {
+        Random rng(seed);
+        std::vector<Lit> terms;
+        out << "* #variable= " << nVars << " #constraint= " << nConstraints << '\n';
+        out << "min:";
+        for (unsigned v = 1; v <= nVars; ++v) out << " +1 x" << v;
+        out << " ;\n";
+        for (uint64_t i = 0; i < nConstraints; ++i) {
+            random_clause(rng, k, terms, [&] () { return 1 + rng.below(nVars); });
+            uint64_t sum = 0;
+            for (Lit lit : terms) {
+                uint64_t coeff = 1 + rng.below(maxCoeff);
+                sum += coeff;
+                out << '+' << coeff << (lit.sign() ? " ~x" : " x") << static_cast<unsigned>(lit.var()) << ' ';
+            }
+            out << ">= " << (sum + 1) / 2 << " ;\n";
+        }
+    }
+};
+
+/**
+ * @brief Parameters of all generators, not every generator uses every parameter
+ */
+struct Parameters {
+    unsigned vars = 1000;
+    uint64_t clauses = 4200;  // clauses, hard clauses (wcnf) or constraints (opb)
+    unsigned k = 3;  // clause or constraint length
+    unsigned communities = 40;
+    double modularity = 0.8;
+    unsigned inputs = 100;  // circuit
+    unsigned gates = 1000;
+    double xor_ratio = 0.2;
+    double or_ratio = 0.3;
+    double mux_ratio = 0;
+    double wide_mux_ratio = 0;
+    unsigned window = 200;
+    uint64_t soft = 1000;  // wcnf
+    uint64_t max_weight = 100;
+    uint64_t max_coeff = 10;  // opb
+    uint64_t seed = 1;
+};
+
+inline const std::vector<std::string> types = { "kcnf", "community", "circuit", "wcnf", "opb" };
+
+// writes an instance of the given type, throws std::invalid_argument for unknown types or inconsistent parameters
+inline void write(const std::string& type, const Parameters& p, InstanceWriter& out) {
+    if (type == "kcnf") {
+        RandomKCNF(p.vars, p.clauses, p.k, p.seed).write(out);
+    } else if (type == "community") {
+        CommunityCNF(p.vars, p.clauses, p.k, p.communities, p.modularity, p.seed).write(out);
+    } else if (type == "circuit") {
+        TseitinCircuit(p.inputs, p.gates, p.xor_ratio, p.or_ratio, p.mux_ratio, p.wide_mux_ratio, p.window, p.seed).write(out);
+    } else if (type == "wcnf") {
+        RandomWCNF(p.vars, p.clauses, p.soft, p.k, p.max_weight, p.seed).write(out);
+    } else if (type == "opb") {
+        RandomOPB(p.vars, p.clauses, p.k, p.max_coeff, p.seed).write(out);
+    } else {
+        throw std::invalid_argument("Unknown instance type: " + type);
+    }
+}
+
+}  // namespace generate
+
+#endif  // SRC_GENERATE_GENERATORS_H_
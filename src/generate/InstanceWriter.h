@@ -0,0 +1,147 @@
+/**
+ * MIT License
+ * Copyright (c) 2024 Markus Iser
+ */
+
+#ifndef SRC_GENERATE_INSTANCEWRITER_H_
+#define SRC_GENERATE_INSTANCEWRITER_H_
+
+#include <algorithm>
+#include <charconv>
+#include <cstdio>
+#include <cstdint>
+#include <cstring>
+#include <initializer_list>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "src/util/SolverTypes.h"
+#include "src/util/StreamCompressor.h"
+
+/**
+ * @brief Buffered text output of generated instances
+ * Files ending with .xz are compressed on the fly with StreamCompressor, "-" writes to stdout.
+ */
+class InstanceWriter {
+    std::unique_ptr<StreamCompressor> compressor;
+    FILE* file;
+    std::vector<char> buffer;
+    size_t pos;
+    uint64_t bytes;
+
+    static constexpr size_t capacity = 1 << 16;
+
+    void flush() {
+        if (compressor) {
+            compressor->write(buffer.data(), pos);
+        } else if (fwrite(buffer.data(), 1, pos, file) != pos) {
+            throw std::runtime_error("Error writing generated instance");
+        }
+        bytes += pos;
+        pos = 0;
+    }
+
+    inline void reserve(size_t n) {
+        if (pos + n > capacity) flush();
+    }
+
+ public:
+    explicit InstanceWriter(const char* output) : compressor(), file(nullptr), buffer(capacity), pos(0), bytes(0) {
+        size_t len = strlen(output);
+        if (strcmp(output, "-") == 0) {
+            file = stdout;
+        } else if (len > 3 && strcmp(output + len - 3, ".xz") == 0) {
+            compressor.reset(new StreamCompressor(output));
+        } else {
+            file = fopen(output, "w");
+            if (file == nullptr) throw std::runtime_error(std::string("Error opening file: ") + output);
+        }
+    }
+
+    ~InstanceWriter() {
+        try {
+            close();
+        } catch (const std::exception&) { }  // incomplete output after an error
+    }
+
+    InstanceWriter(const InstanceWriter&) = delete;
+    InstanceWriter& operator=(const InstanceWriter&) = delete;
+
+    void close() {
+        if (compressor || file != nullptr) flush();
+        if (compressor) {
+            compressor->close();
+            compressor.reset();
+        } else if (file != nullptr && file != stdout) {
+            fclose(file);
+        }
+        file = nullptr;
+    }
+
+    inline InstanceWriter& operator<<(const char* str) {
+        for (size_t len = strlen(str); len > 0; ) {
+            if (pos == capacity) flush();
+            size_t n = std::min(len, capacity - pos);
+            memcpy(buffer.data() + pos, str, n);
+            pos += n;
+            str += n;
+            len -= n;
+        }
+        return *this;
+    }
+
+    inline InstanceWriter& operator<<(const std::string& str) {
+        return *this << str.c_str();
+    }
+
+    inline InstanceWriter& operator<<(char c) {
+        reserve(1);
+        buffer[pos++] = c;
+        return *this;
+    }
+
+    inline InstanceWriter& operator<<(int64_t value) {
+        reserve(21);
+        pos = std::to_chars(buffer.data() + pos, buffer.data() + pos + 21, value).ptr - buffer.data();
+        return *this;
+    }
+
+    inline InstanceWriter& operator<<(uint64_t value) {
+        reserve(21);
+        pos = std::to_chars(buffer.data() + pos, buffer.data() + pos + 21, value).ptr - buffer.data();
+        return *this;
+    }
+
+    inline InstanceWriter& operator<<(int value) {
+        return *this << static_cast<int64_t>(value);
+    }
+
+    inline InstanceWriter& operator<<(unsigned value) {
+        return *this << static_cast<uint64_t>(value);
+    }
+
+    // literals in DIMACS notation
+    inline InstanceWriter& operator<<(Lit lit) {
+        return *this << static_cast<int64_t>(lit.toDimacs());
+    }
+
+    // clause in DIMACS notation, terminated by 0 and newline
+    template <typename Clause>
+    inline void clause(const Clause& lits) {
+        for (Lit lit : lits) *this << lit << ' ';
+        *this << "0\n";
+    }
+
+    inline void clause(std::initializer_list<Lit> lits) {
+        clause<std::initializer_list<Lit>>(lits);
+    }
+
+    // uncompressed bytes written so far
+    inline uint64_t size() const {
+        return bytes + pos;
+    }
+};
+
+#endif  // SRC_GENERATE_INSTANCEWRITER_H_
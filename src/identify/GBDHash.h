@@ -25,9 +25,12 @@ OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWA
 
 #include "src/external/md5/md5.h"
 #include "src/util/StreamBuffer.h"
+#include "src/util/Profile.h"
+#include "src/util/Timer.h"
 
 namespace CNF {
     std::string gbdhash(const char* filename) {
+        PhaseTimer::Measure parse(PhaseTimer::PARSE);
         MD5 md5;
         StreamBuffer in(filename);
         bool notfirst = false;
@@ -43,6 +46,7 @@ namespace CNF {
                     md5.consume(" ", 1);
                 }
                 md5.consume("0", 1);
+                GBDC_PROFILE_COUNT(CLAUSES, 1);
                 notfirst = true;
             }
         }
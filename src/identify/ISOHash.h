@@ -28,9 +28,39 @@ OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWA
 
 #include "src/util/StreamBuffer.h"
 #include "src/util/SolverTypes.h"
+#include "src/util/CNFFormula.h"
+#include "src/util/RawClauses.h"
+#include "src/util/Timer.h"
 
 
 namespace CNF {
+    struct LiteralDegree { unsigned neg; unsigned pos; };
+
+    /**
+     * @brief Hashsum of the given (variable-indexed) literal degrees
+     * @param degrees positive and negative occurrence counts of each variable, gets sorted
+     * @return std::string isohash
+     */
+    std::string isohash(std::vector<LiteralDegree>& degrees) {
+        // get invariant w.r.t. polarity flips
+        for (LiteralDegree& degree : degrees) {
+            if (degree.pos < degree.neg) std::swap(degree.pos, degree.neg);
+        }
+        // sort lexicographically by degree
+        std::sort(degrees.begin(), degrees.end(), [](const LiteralDegree& one, const LiteralDegree& two) { 
+            return one.neg != two.neg ? one.neg < two.neg : one.pos < two.pos; 
+        } );
+        // hash
+        MD5 md5;
+        char buffer[64];
+        for (LiteralDegree node : degrees) {
+            if (node.neg == 0 && node.pos == 0) continue;  // get invariant against variable gaps
+            int n = snprintf(buffer, sizeof(buffer), "%u %u ", node.neg, node.pos);
+            md5.consume(buffer, n);
+        }
+        return md5.produce();
+    }
+
     /**
      * @brief Hashsum of ordered degree sequence of literal incidence graph
      * - literal nodes are grouped pairwise and sorted lexicographically
@@ -39,9 +69,9 @@ namespace CNF {
      * @return std::string isohash
      */
     std::string isohash(const char* filename) {
+        PhaseTimer::Measure parse(PhaseTimer::PARSE);
         StreamBuffer in(filename);
-        struct Node { unsigned neg; unsigned pos; };
-        std::vector<Node> degrees;
+        std::vector<LiteralDegree> degrees;
         while (in.skipWhitespace()) {
             if (*in == 'p' || *in == 'c') {
                 if (!in.skipLine()) break;
@@ -55,23 +85,40 @@ namespace CNF {
                 }
             }
         }
-        // get invariant w.r.t. polarity flips
-        for (Node& degree : degrees) {
-            if (degree.pos < degree.neg) std::swap(degree.pos, degree.neg);
+        return isohash(degrees);
+    }
+
+    /**
+     * @brief Isohash of the raw clauses of a file, equal to the isohash of the file
+     * @param clauses clauses as read from the benchmark instance
+     * @return std::string isohash
+     */
+    std::string isohash(const RawClauses& clauses) {
+        std::vector<LiteralDegree> degrees;
+        for (size_t i = 0; i < clauses.nClauses(); ++i) {
+            for (Lit lit : clauses[i]) {
+                if (static_cast<size_t>(lit.var()) > degrees.size()) degrees.resize(lit.var());
+                if (lit.sign()) ++degrees[lit.var() - 1].neg;
+                else ++degrees[lit.var() - 1].pos;
+            }
         }
-        // sort lexicographically by degree
-        std::sort(degrees.begin(), degrees.end(), [](const Node& one, const Node& two) { 
-            return one.neg != two.neg ? one.neg < two.neg : one.pos < two.pos; 
-        } );
-        // hash
-        MD5 md5;
-        char buffer[64];
-        for (Node node : degrees) {
-            if (node.neg == 0 && node.pos == 0) continue;  // get invariant against variable gaps
-            int n = snprintf(buffer, sizeof(buffer), "%u %u ", node.neg, node.pos);
-            md5.consume(buffer, n);
+        return isohash(degrees);
+    }
+
+    /**
+     * @brief Isohash of a loaded formula, equal to the isohash of its file if that is sanitized
+     * @param formula benchmark instance
+     * @return std::string isohash
+     */
+    std::string isohash(const CNFFormula& formula) {
+        std::vector<LiteralDegree> degrees(formula.nVars());
+        for (const Cl* clause : formula) {
+            for (Lit lit : *clause) {
+                if (lit.sign()) ++degrees[lit.var() - 1].neg;
+                else ++degrees[lit.var() - 1].pos;
+            }
         }
-        return md5.produce();
+        return isohash(degrees);
     }
 } // namespace CNF
 
@@ -27,26 +27,31 @@ OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWA
 
 #include <stdexcept>
 #include "src/util/CNFFormula.h"
+#include "src/util/OccurrenceIndex.h"
 
 class IndependentSetFromCNF {
  private:
-    CNFFormula F;
-    std::vector<std::vector<unsigned>> literal2nodes;
+    CNFFormula owned;  // formula read from file, empty if constructed from a loaded formula
+    const CNFFormula& F;
+    CompressedIndex<unsigned> literal2nodes;
 
     unsigned nNodes;
     unsigned nEdges;
     unsigned k;
 
- public:
-    explicit IndependentSetFromCNF(const char* filename) : F(), literal2nodes(), nNodes(0), nEdges(0) {
-        F.readDimacsFromFile(filename);
-        literal2nodes.resize(2 * F.nVars() + 2);
-        unsigned nodeId = 1;
+    void init() {
+        literal2nodes = CompressedIndex<unsigned>(2 * F.nVars() + 2);
         for (Cl* clause : F) {
             nNodes += clause->size();  // one node per literal occurence
             nEdges += (clause->size() * (clause->size() - 1)) / 2;  // number of edges in clique
+            for (Lit lit : *clause) {
+                literal2nodes.count(lit);
+            }
+        }
+        unsigned nodeId = 1;
+        for (Cl* clause : F) {
             for (unsigned i = 0; i < clause->size(); i++) {
-                literal2nodes[(*clause)[i]].push_back(nodeId + i);  // remember nodeids of literals
+                literal2nodes.insert((*clause)[i], nodeId + i);  // remember nodeids of literals
             }
             nodeId += clause->size();
         }
@@ -57,6 +62,15 @@ class IndependentSetFromCNF {
         k = F.nClauses();
     }
 
+ public:
+    explicit IndependentSetFromCNF(const char* filename) : owned(filename), F(owned), literal2nodes(), nNodes(0), nEdges(0) {
+        init();
+    }
+
+    explicit IndependentSetFromCNF(const CNFFormula& formula) : owned(), F(formula), literal2nodes(), nNodes(0), nEdges(0) {
+        init();
+    }
+
     unsigned numNodes() {
         return nNodes;
     }
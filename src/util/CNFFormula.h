@@ -27,20 +27,39 @@ OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWA
 
 #include "src/util/StreamBuffer.h"
 #include "src/util/SolverTypes.h"
+#include "src/util/ClauseHashTable.h"
+#include "src/util/VariableRenaming.h"
+#include "src/util/ResourceBudget.h"
+#include "src/util/Profile.h"
 
 class CNFFormula {
     For formula;
     unsigned variables;
+    unsigned duplicates;  // number of dropped duplicate clauses
+
+    // optional duplicate-clause detection (enabled if not null)
+    std::unique_ptr<ClauseHashTable> clauses;
+
+    // optional gapless renaming of variables while reading (enabled if not null)
+    std::unique_ptr<VariableRenaming> renaming;
+
+    // clause storage, which is accounted to the resource budget of the current thread (if any) while reading
+    static inline size_t bytes(const Cl& clause) {
+        return sizeof(Cl) + clause.capacity() * sizeof(Lit);
+    }
 
  public:
-    CNFFormula() : formula(), variables(0) { }
+    CNFFormula() : formula(), variables(0), duplicates(0), clauses(), renaming() { }
 
-    explicit CNFFormula(const char* filename) : CNFFormula() {
+    explicit CNFFormula(const char* filename, bool deduplicate = false) : CNFFormula() {
+        if (deduplicate) enableDeduplication();
         readDimacsFromFile(filename);
     }
 
     ~CNFFormula() {
+        ResourceBudget* budget = ResourceBudget::current();
         for (Cl* clause : formula) {
+            if (budget != nullptr) budget->release(bytes(*clause));
             delete clause;
         }
     }
@@ -67,41 +86,75 @@ class CNFFormula {
         return formula.size();
     }
 
+    inline size_t nDuplicates() const {
+        return duplicates;
+    }
+
     inline int newVar() {
         return ++variables;
     }
 
     inline void clear() {
         formula.clear();
+        if (clauses) clauses->clear();
+        if (renaming) renaming->clear();
+    }
+
+    /**
+     * @brief Drop clauses which are equal to a previously read clause (after sanitization)
+     * Must be enabled before reading clauses in order to catch all duplicates.
+     */
+    void enableDeduplication() {
+        if (!clauses) clauses.reset(new ClauseHashTable(formula, formula.size()));
+    }
+
+    /**
+     * @brief Rename variables to 1..n in order of first occurrence while reading clauses
+     * All tables sized by nVars() are then proportional to the number of distinct variables,
+     * independent of the magnitude of the variable ids in the input.
+     * Must be enabled before reading clauses.
+     */
+    void enableRenaming() {
+        if (!renaming && formula.empty()) renaming.reset(new VariableRenaming());
+    }
+
+    inline bool isRenamed() const {
+        return renaming != nullptr;
     }
 
-    // create gapless representation of variables
+    // original name of a variable, if renaming is enabled
+    inline Var originalName(Var var) const {
+        return renaming ? renaming->originalName(var) : var;
+    }
+
+    // create gapless representation of variables (post-pass, prefer enableRenaming() before reading)
     void normalizeVariableNames() {
-        std::vector<unsigned> name;
-        name.resize(variables+1, 0);
-        unsigned int max = 0;
+        VariableRenaming names;
         for (Cl* clause : formula) {
             for (Lit& lit : *clause) {
-                if (name[lit.var()] == 0) name[lit.var()] = max++;
-                lit = Lit(name[lit.var()], lit.sign());
+                lit = names.rename(lit);
             }
+            std::sort(clause->begin(), clause->end());
         }
-        variables = max;
+        variables = names.size();
     }
 
     void readDimacsFromFile(const char* filename) {
+        PhaseTimer::Measure parse(PhaseTimer::PARSE);
         StreamBuffer in(filename);
         Cl clause;
         while (in.skipWhitespace()) {
             if (*in == 'p' || *in == 'c') {
                 if (!in.skipLine()) break;
             } else {
+                ResourceBudget::checkpoint();
                 int plit;
                 while (in.readInteger(&plit)) {
                     if (plit == 0) break;
                     clause.push_back(Lit(abs(plit), plit < 0));
                 }
                 readClause(clause.begin(), clause.end());
+                GBDC_PROFILE_COUNT(CLAUSES, 1);
                 clause.clear();
             }
         }
@@ -138,8 +191,28 @@ class CNFFormula {
             }
             clause->resize(clause->size() - dup);
             clause->shrink_to_fit();
+        }
+        if (renaming) {  // after removal of tautologies, such that only variables of stored clauses are named
+            for (Iterator it = begin; it != end; ++it) renaming->rename(*it);  // name in order of appearance
+            for (Lit& lit : *clause) lit = renaming->rename(lit);
+            std::sort(clause->begin(), clause->end());
+        }
+        if (clauses && !clauses->insert(*clause, formula.size())) {
+            ++duplicates;
+            delete clause;
+            return;  // no duplicate clauses
+        }
+        if (clause->size() > 0) {
             variables = std::max(variables, (unsigned int)clause->back().var());
         }
+        if (ResourceBudget* budget = ResourceBudget::current()) {
+            try {
+                budget->charge(bytes(*clause));
+            } catch (const MemoryLimitExceeded&) {
+                delete clause;
+                throw;
+            }
+        }
         formula.push_back(clause);
     }
 };
@@ -7,6 +7,9 @@
 
 #include <algorithm>
 #include <cmath>
+#include <type_traits>
+
+#include "src/util/ResourceBudget.h"
 
 template <typename Container>
 double Mean(Container&& distribution) {
@@ -83,7 +86,40 @@ void push_distribution(V&& record, W&& distribution) {
     double variance = Variance(distribution, mean);
     double min = distribution.front();
     double max = distribution.back();
-    double entropy = ScaledEntropy(distribution);
+    double entropy;
+    if constexpr (std::is_floating_point<typename std::decay_t<W>::value_type>::value) {
+        entropy = ScaledEntropy(std::vector<double>(distribution.begin(), distribution.end()));  // snapped values
+    } else {
+        entropy = ScaledEntropy(distribution);
+    }
+    record.insert(record.end(), { mean, variance, min, max, entropy });
+}
+
+void push_histogram(std::vector<double>& record, const std::vector<uint64_t>& histogram) {
+    uint64_t total = 0, sum = 0;
+    std::unordered_map<int64_t, int64_t> occurence;
+    for (size_t value = 0; value < histogram.size(); ++value) {
+        if (histogram[value] == 0) continue;
+        total += histogram[value];
+        sum += value * histogram[value];
+        occurence[value] = histogram[value];
+    }
+    if (total == 0) {
+        record.insert(record.end(), { 0, 0, 0, 0, 0 });
+        return;
+    }
+    double mean = static_cast<double>(sum) / total;
+    double variance = 0.0;
+    double min = -1, max = 0;
+    for (size_t value = 0; value < histogram.size(); ++value) {
+        if (histogram[value] == 0) continue;
+        double diff = value - mean;
+        variance += diff * diff * histogram[value];
+        if (min < 0) min = value;
+        max = value;
+    }
+    variance /= total;
+    double entropy = ScaledEntropyFromOccurenceCounts(occurence, total);
     record.insert(record.end(), { mean, variance, min, max, entropy });
 }
 
@@ -91,4 +127,7 @@ void push_distribution(V&& record, W&& distribution) {
 template void push_distribution<std::vector<double, std::allocator<double> >&, std::vector<unsigned int, std::allocator<unsigned int> >&>(std::vector<double, std::allocator<double> >&, std::vector<unsigned int, std::allocator<unsigned int> >&);
 template void push_distribution<std::vector<double, std::allocator<double> >&, std::vector<double, std::allocator<double> >&>(std::vector<double, std::allocator<double> >&, std::vector<double, std::allocator<double> >&);
 template void push_distribution<std::vector<double, std::allocator<double> >&, std::vector<unsigned long, std::allocator<unsigned long> >&>(std::vector<double, std::allocator<double> >&, std::vector<unsigned long, std::allocator<unsigned long> >&);
-template void push_distribution<std::vector<double, std::allocator<double> >&, std::vector<unsigned long long, std::allocator<unsigned long long> >&>(std::vector<double, std::allocator<double> >&, std::vector<unsigned long long, std::allocator<unsigned long long> >&);
\ No newline at end of file
+template void push_distribution<std::vector<double, std::allocator<double> >&, std::vector<unsigned long long, std::allocator<unsigned long long> >&>(std::vector<double, std::allocator<double> >&, std::vector<unsigned long long, std::allocator<unsigned long long> >&);
+template void push_distribution<std::vector<double>&, BudgetVector<unsigned>&>(std::vector<double>&, BudgetVector<unsigned>&);
+template void push_distribution<std::vector<double>&, BudgetVector<double>&>(std::vector<double>&, BudgetVector<double>&);
+template void push_distribution<std::vector<double>&, BudgetVector<uint64_t>&>(std::vector<double>&, BudgetVector<uint64_t>&);
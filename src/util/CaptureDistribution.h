@@ -23,4 +23,13 @@ template <typename Container>
 double ScaledEntropy(Container&& distribution);
 
 template <typename V, typename W> 
-void push_distribution(V&& record, W&& distribution);
\ No newline at end of file
+void push_distribution(V&& record, W&& distribution);
+
+// increment the count of value in the histogram
+inline void add_to_histogram(std::vector<uint64_t>& histogram, size_t value) {
+    if (histogram.size() <= value) histogram.resize(value + 1, 0);
+    ++histogram[value];
+}
+
+// same record as push_distribution for the distribution given by its histogram (histogram[v] = number of occurrences of v)
+void push_histogram(std::vector<double>& record, const std::vector<uint64_t>& histogram);
\ No newline at end of file
@@ -0,0 +1,98 @@
+/**
+ * MIT License
+ * Copyright (c) 2024 Markus Iser
+ */
+
+#ifndef SRC_UTIL_CLAUSEHASHTABLE_H_
+#define SRC_UTIL_CLAUSEHASHTABLE_H_
+
+#include <cstdint>
+#include <vector>
+
+#include "src/util/SolverTypes.h"
+
+/**
+ * @brief Open-addressing hash set of sanitized (sorted, duplicate-free) clauses
+ *
+ * Slots store the position of the clause in its formula and a 32-bit fingerprint of the clause.
+ * The fingerprint doubles as bucket address, such that growing the table never touches the clauses.
+ * Linear probing with a maximum load factor of 1/2 keeps the expected probe length constant.
+ */
+class ClauseHashTable {
+    static constexpr uint32_t empty_ = UINT32_MAX;
+
+    struct Slot {
+        uint32_t index = empty_;  // position of clause in formula
+        uint32_t fingerprint = 0;
+    };
+
+    const For& formula_;
+    std::vector<Slot> slots;
+    size_t mask;
+    size_t count;
+
+    static uint32_t hash(const Cl& clause) {
+        uint64_t h = 0xcbf29ce484222325ULL ^ clause.size();
+        for (Lit lit : clause) {
+            h = (h ^ lit.x) * 0x100000001b3ULL;
+        }
+        // splitmix64 finalizer
+        h = (h ^ (h >> 30)) * 0xbf58476d1ce4e5b9ULL;
+        h = (h ^ (h >> 27)) * 0x94d049bb133111ebULL;
+        return static_cast<uint32_t>(h ^ (h >> 31));
+    }
+
+    void grow() {
+        std::vector<Slot> old;
+        old.swap(slots);
+        slots.resize(old.size() * 2);
+        mask = slots.size() - 1;
+        for (const Slot& slot : old) {
+            if (slot.index != empty_) {
+                size_t pos = slot.fingerprint & mask;
+                while (slots[pos].index != empty_) pos = (pos + 1) & mask;
+                slots[pos] = slot;
+            }
+        }
+    }
+
+ public:
+    explicit ClauseHashTable(const For& formula, size_t capacity = 1024) : formula_(formula), slots(), count(0) {
+        size_t size = 16;
+        while (size < 2 * capacity) size <<= 1;
+        slots.resize(size);
+        mask = size - 1;
+    }
+
+    /**
+     * @brief insert clause with given position in formula unless an equal clause is present
+     * @pre clause is sorted and free of duplicate literals
+     * @return true if clause was inserted, false if it is a duplicate
+     */
+    bool insert(const Cl& clause, uint32_t index) {
+        if (2 * (count + 1) > slots.size()) grow();
+        uint32_t fingerprint = hash(clause);
+        size_t pos = fingerprint & mask;
+        while (slots[pos].index != empty_) {
+            if (slots[pos].fingerprint == fingerprint && *formula_[slots[pos].index] == clause) {
+                return false;
+            }
+            pos = (pos + 1) & mask;
+        }
+        slots[pos].index = index;
+        slots[pos].fingerprint = fingerprint;
+        ++count;
+        return true;
+    }
+
+    void clear() {
+        std::fill(slots.begin(), slots.end(), Slot());
+        count = 0;
+    }
+
+    inline size_t size() const {
+        return count;
+    }
+};
+
+#endif  // SRC_UTIL_CLAUSEHASHTABLE_H_
@@ -0,0 +1,208 @@
+/**
+ * MIT License
+ * Copyright (c) 2024 Markus Iser
+ */
+
+#ifndef SRC_UTIL_OCCURRENCEINDEX_H_
+#define SRC_UTIL_OCCURRENCEINDEX_H_
+
+#include <cstddef>
+#include <vector>
+#include <algorithm>
+#include <memory>
+#include <utility>
+
+#include "src/util/SolverTypes.h"
+#include "src/util/CNFFormula.h"
+#include "src/util/ResourceBudget.h"
+
+/**
+ * @brief Non-owning view of a contiguous range, e.g., the occurrences of a literal
+ */
+template <typename T>
+class Span {
+    T* begin_;
+    T* end_;
+
+ public:
+    Span() : begin_(nullptr), end_(nullptr) { }
+    Span(T* begin, T* end) : begin_(begin), end_(end) { }
+
+    template <typename U, typename = decltype(std::declval<U&>().data())>
+    Span(U& container) : begin_(container.data()), end_(container.data() + container.size()) { }  // NOLINT
+
+    inline T* begin() const { return begin_; }
+    inline T* end() const { return end_; }
+    inline size_t size() const { return end_ - begin_; }
+    inline bool empty() const { return begin_ == end_; }
+    inline T& operator[] (size_t i) const { return begin_[i]; }
+    inline T& front() const { return *begin_; }
+    inline T& back() const { return *(end_ - 1); }
+};
+
+typedef Span<Cl* const> ClauseSpan;
+
+/**
+ * @brief Compressed sparse row (CSR) index: all lists are stored consecutively in one array
+ *
+ * Built in two passes over the data: first count() the entries of each key,
+ * then insert() each entry once more. The first insert() turns the counts into offsets (prefix sum).
+ */
+template <typename T>
+class CompressedIndex {
+ protected:
+    std::vector<size_t> offsets;  // list of key k is entries[offsets[k], offsets[k+1])
+    std::vector<T, BudgetAllocator<T>> entries;
+    bool counting;
+
+    void allocate() {
+        // prefix sum over counts, offsets[k+1] is the insert position of key k until insertion is complete
+        size_t total = 0;
+        for (size_t k = 1; k < offsets.size(); ++k) {
+            size_t count = offsets[k];
+            offsets[k] = total;
+            total += count;
+        }
+        entries.resize(total);
+        counting = false;
+    }
+
+ public:
+    explicit CompressedIndex(size_t keys = 0) : offsets(keys + 1, 0), entries(), counting(true) { }
+
+    inline void count(size_t key) {
+        ++offsets[key + 1];
+    }
+
+    inline void insert(size_t key, T value) {
+        if (counting) allocate();
+        entries[offsets[key + 1]++] = value;
+    }
+
+    inline Span<T> operator[] (size_t key) {
+        return Span<T>(entries.data() + offsets[key], entries.data() + offsets[key + 1]);
+    }
+
+    inline Span<const T> operator[] (size_t key) const {
+        return Span<const T>(entries.data() + offsets[key], entries.data() + offsets[key + 1]);
+    }
+
+    inline size_t begin(size_t key) const {
+        return offsets[key];
+    }
+
+    inline size_t end(size_t key) const {
+        return offsets[key + 1];
+    }
+
+    // number of keys
+    inline size_t size() const {
+        return offsets.size() - 1;
+    }
+
+    // total number of entries
+    inline size_t nEntries() const {
+        return entries.size();
+    }
+
+    inline T* data() {
+        return entries.data();
+    }
+};
+
+/**
+ * @brief Literal to clause occurrence index of a formula, built once and shared by the occurrence-based data structures
+ * Clauses of a literal are listed in formula order. A shared index is const, consumers modify their lists through OccurrenceLists.
+ */
+class OccurrenceIndex : public CompressedIndex<Cl*> {
+ public:
+    /**
+     * @param formula the formula
+     * @param skip_units if true, unit clauses are not indexed
+     */
+    explicit OccurrenceIndex(const CNFFormula& formula, bool skip_units = false) : CompressedIndex(2 + 2 * formula.nVars()) {
+        for (const Cl* clause : formula) {
+            if (skip_units && clause->size() == 1) continue;
+            for (Lit lit : *clause) count(lit);
+        }
+        allocate();
+        for (Cl* clause : formula) {
+            if (skip_units && clause->size() == 1) continue;
+            for (Lit lit : *clause) insert(lit, clause);
+        }
+    }
+};
+
+/**
+ * @brief Modifiable occurrence lists of one consumer (e.g., OccurrenceList or BlockList) on top of an OccurrenceIndex
+ * The list of literal l is list(l)[0, length(l)). Lists of a shared index are copied on their first modification (copy on write),
+ * lists which are only read stay in the shared index. Without a shared index, an own index is built and modified in place.
+ */
+class OccurrenceLists {
+    std::unique_ptr<OccurrenceIndex> owned;  // if no shared index is given
+    const OccurrenceIndex& index;
+    std::vector<Cl* const*> begins;  // current storage of each list
+    std::vector<Cl**> copies;  // modifiable storage of each list, or nullptr if the list is still shared
+    std::vector<unsigned> lengths;
+    std::vector<BudgetVector<Cl*>> chunks;  // storage of copied lists, chunks never grow beyond their capacity such that lists do not move
+
+    static constexpr size_t chunk_size = 1 << 16;
+
+    Cl** copy(size_t lit) {
+        if (chunks.empty() || chunks.back().capacity() - chunks.back().size() < lengths[lit]) {
+            chunks.emplace_back();
+            chunks.back().reserve(std::max<size_t>(chunk_size, lengths[lit]));
+        }
+        BudgetVector<Cl*>& chunk = chunks.back();
+        Cl** result = chunk.data() + chunk.size();
+        chunk.insert(chunk.end(), begins[lit], begins[lit] + lengths[lit]);
+        begins[lit] = copies[lit] = result;
+        return result;
+    }
+
+ public:
+    /**
+     * @param formula the formula
+     * @param shared occurrence index of the non-unit clauses of formula (see OccurrenceIndex(formula, true)), which is not modified,
+     * or nullptr to build an own index
+     */
+    OccurrenceLists(const CNFFormula& formula, const OccurrenceIndex* shared)
+     : owned(shared == nullptr ? new OccurrenceIndex(formula, true) : nullptr), index(shared == nullptr ? *owned : *shared),
+       begins(index.size()), copies(index.size(), nullptr), lengths(index.size()), chunks() {
+        for (size_t lit = 0; lit < index.size(); ++lit) {
+            begins[lit] = index[lit].begin();
+            lengths[lit] = index.end(lit) - index.begin(lit);
+        }
+        if (owned) {
+            for (size_t lit = 0; lit < index.size(); ++lit) {
+                copies[lit] = owned->data() + index.begin(lit);
+            }
+        }
+    }
+
+    inline ClauseSpan operator[] (size_t lit) const {
+        return ClauseSpan(begins[lit], begins[lit] + lengths[lit]);
+    }
+
+    // modifiable list of literal lit, its length is changed with truncate()
+    inline Span<Cl*> modify(size_t lit) {
+        Cl** begin = copies[lit] != nullptr ? copies[lit] : copy(lit);
+        return Span<Cl*>(begin, begin + lengths[lit]);
+    }
+
+    // shortens the list of literal lit to its first length clauses
+    inline void truncate(size_t lit, unsigned length) {
+        lengths[lit] = length;
+    }
+
+    inline unsigned length(size_t lit) const {
+        return lengths[lit];
+    }
+
+    // number of lists
+    inline size_t size() const {
+        return index.size();
+    }
+};
+
+#endif  // SRC_UTIL_OCCURRENCEINDEX_H_
@@ -0,0 +1,111 @@
+/**
+ * MIT License
+ * Copyright (c) 2024 Markus Iser
+ */
+
+#ifndef SRC_UTIL_PROFILE_H_
+#define SRC_UTIL_PROFILE_H_
+
+#include <cstdint>
+#include <memory>
+#include <sstream>
+#include <string>
+
+#include "src/util/Timer.h"
+#include "src/util/ResourceBudget.h"
+
+/**
+ * @brief Profile of a single run: phase times, peak memory per phase and event counters
+ *
+ * Phase times and memory are always available (see PhaseTimer).
+ * Event counters are incremented with GBDC_PROFILE_COUNT(), which compiles to nothing
+ * unless the build defines GBDC_PROFILE (cmake -DGBDC_PROFILE=ON).
+ */
+class Profile {
+ public:
+    // semantic gate checks are decided by truth tables, propagation or SAT calls (in this order)
+    enum Counter { BYTES_READ = 0, TOKENS, CLAUSES, BLOCKED_SET_CHECKS, TRUTH_TABLES, PROPAGATIONS, SAT_CALLS, N_COUNTERS };
+
+    static constexpr const char* counter_names[N_COUNTERS] = {
+        "bytes_read", "tokens", "clauses", "blocked_set_checks", "truth_tables", "propagations", "sat_calls"
+    };
+
+#ifdef GBDC_PROFILE
+    static constexpr bool counters_enabled = true;
+#else
+    static constexpr bool counters_enabled = false;
+#endif
+
+ private:
+    static inline thread_local Profile* current_ = nullptr;
+
+    uint64_t counters_[N_COUNTERS] = { };
+    PhaseTimer timer_;
+    ResourceBudget budget_;  // unlimited, for memory accounting if no other budget is installed
+
+ public:
+    Profile() : timer_(), budget_() { }
+
+    /**
+     * @brief Installs the profile and its phase timer on the current thread for the lifetime of the scope
+     */
+    class Scope {
+        Profile* previous_;
+        std::unique_ptr<ResourceBudget::Scope> budget_;
+        PhaseTimer::Scope timer_;
+
+     public:
+        explicit Scope(Profile& profile) : previous_(current_),
+         budget_(ResourceBudget::current() == nullptr ? new ResourceBudget::Scope(profile.budget_) : nullptr),
+         timer_(profile.timer_) {
+            current_ = &profile;
+        }
+
+        ~Scope() {
+            current_ = previous_;
+        }
+
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+    };
+
+    static inline void count(Counter counter, uint64_t n = 1) {
+        if (current_ != nullptr) current_->counters_[counter] += n;
+    }
+
+    inline uint64_t counter(Counter counter) const {
+        return counters_[counter];
+    }
+
+    inline const PhaseTimer& timer() const {
+        return timer_;
+    }
+
+    // profile as single-line JSON object
+    std::string json() const {
+        std::stringstream out;
+        out << "{\"phases\": {";
+        for (unsigned p = 0; p < PhaseTimer::N_PHASES; ++p) {
+            PhaseTimer::Phase phase = PhaseTimer::Phase(p);
+            out << (p > 0 ? ", " : "") << "\"" << PhaseTimer::names[p] << "\": {"
+                << "\"wall_ns\": " << timer_.wallNs(phase) << ", "
+                << "\"cpu_ns\": " << timer_.cpuNs(phase) << ", "
+                << "\"peak_bytes\": " << timer_.peakBytes(phase) << "}";
+        }
+        out << "}, \"wall_ns\": " << timer_.wallNs() << ", \"cpu_ns\": " << timer_.cpuNs();
+        out << ", \"counters_enabled\": " << (counters_enabled ? "true" : "false") << ", \"counters\": {";
+        for (unsigned c = 0; c < N_COUNTERS; ++c) {
+            out << (c > 0 ? ", " : "") << "\"" << counter_names[c] << "\": " << counters_[c];
+        }
+        out << "}}";
+        return out.str();
+    }
+};
+
+#ifdef GBDC_PROFILE
+    #define GBDC_PROFILE_COUNT(counter, n) Profile::count(Profile::counter, n)
+#else
+    #define GBDC_PROFILE_COUNT(counter, n) ((void)0)
+#endif
+
+#endif  // SRC_UTIL_PROFILE_H_
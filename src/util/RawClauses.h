@@ -0,0 +1,70 @@
+/**
+ * MIT License
+ * Copyright (c) 2024 Markus Iser
+ */
+
+#ifndef SRC_UTIL_RAWCLAUSES_H_
+#define SRC_UTIL_RAWCLAUSES_H_
+
+#include <cstddef>
+
+#include "src/util/SolverTypes.h"
+#include "src/util/StreamBuffer.h"
+#include "src/util/OccurrenceIndex.h"
+#include "src/util/ResourceBudget.h"
+#include "src/util/Timer.h"
+
+/**
+ * @brief Clauses of a DIMACS file as they are read, i.e., unsorted and with duplicate literals, tautologies and duplicate clauses
+ * All literals are stored consecutively, such that features of the file can be computed without reading it again.
+ */
+class RawClauses {
+    BudgetVector<Lit> literals;
+    BudgetVector<size_t> offsets;  // clause i is literals[offsets[i], offsets[i+1])
+
+ public:
+    RawClauses() : literals(), offsets(1, 0) { }
+
+    explicit RawClauses(const char* filename) : RawClauses() {
+        readDimacsFromFile(filename);
+    }
+
+    void readDimacsFromFile(const char* filename) {
+        PhaseTimer::Measure parse(PhaseTimer::PARSE);
+        StreamBuffer in(filename);
+        Cl clause;
+        while (in.readClause(clause)) {
+            ResourceBudget::checkpoint();
+            literals.insert(literals.end(), clause.begin(), clause.end());
+            offsets.push_back(literals.size());
+        }
+    }
+
+    inline size_t nClauses() const {
+        return offsets.size() - 1;
+    }
+
+    inline Span<const Lit> operator[] (size_t i) const {
+        return Span<const Lit>(literals.data() + offsets[i], literals.data() + offsets[i + 1]);
+    }
+
+    /**
+     * @brief Clause reader with the interface of StreamBuffer::readClause()
+     */
+    class Reader {
+        const RawClauses& clauses_;
+        size_t pos_ = 0;
+
+     public:
+        explicit Reader(const RawClauses& clauses) : clauses_(clauses) { }
+
+        bool readClause(Cl& out) {
+            if (pos_ >= clauses_.nClauses()) return false;
+            Span<const Lit> clause = clauses_[pos_++];
+            out.assign(clause.begin(), clause.end());
+            return true;
+        }
+    };
+};
+
+#endif  // SRC_UTIL_RAWCLAUSES_H_
@@ -0,0 +1,199 @@
+/**
+ * MIT License
+ * Copyright (c) 2024 Markus Iser
+ */
+
+#ifndef SRC_UTIL_RESOURCEBUDGET_H_
+#define SRC_UTIL_RESOURCEBUDGET_H_
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <memory>
+#include <vector>
+
+struct TimeLimitExceeded : public std::exception {
+    const char* what() const throw() {
+        return "Exceeded Time Limit";
+    }
+};
+
+struct MemoryLimitExceeded : public std::exception {
+    const char* what() const throw() {
+        return "Exceeded Memory Limit";
+    }
+};
+
+/**
+ * @brief Cooperative per-job time and memory budget
+ *
+ * Unlike ResourceLimits, which sets process-wide rlimits and signal handlers, a budget
+ * only affects the thread it is installed on (see Scope). Time is checked at cancellation
+ * points, i.e., calls to ResourceBudget::checkpoint() in parser and analysis loops,
+ * which throw TimeLimitExceeded once the deadline passed or the job was cancelled.
+ * The deadline is wall-clock time, unlike the cpu time limit of ResourceLimits, as a thread has no rlimit of its own.
+ * Memory is accounted by BudgetAllocator (occurrence indexes and the per-variable and distribution vectors
+ * of the extractors) and by the clause storage of CNFFormula, which throw MemoryLimitExceeded instead of allocating
+ * beyond the limit. Other allocations (e.g., stream buffers and solvers) are not accounted.
+ *
+ * A budget is meant to be used by one thread at a time, only cancel() may be called from other threads.
+ */
+class ResourceBudget {
+    typedef std::chrono::steady_clock clock;
+
+    static inline thread_local ResourceBudget* current_ = nullptr;
+
+    clock::time_point start_;
+    clock::time_point deadline_;
+    bool timed_;
+    size_t memory_limit_;  // bytes, 0 = unlimited
+
+    size_t allocated_ = 0;
+    size_t peak_ = 0;
+    size_t interval_peak_ = 0;  // peak since last call of takeIntervalPeak()
+    unsigned countdown_ = 1;  // checkpoints until the next clock read
+    std::atomic<bool> cancelled_;
+
+    static constexpr unsigned interval_ = 1024;
+
+ public:
+    /**
+     * @param rlim time limit in seconds (wall-clock), 0 = unlimited
+     * @param mlim memory limit in mega bytes, 0 = unlimited
+     */
+    explicit ResourceBudget(unsigned rlim = 0, unsigned mlim = 0)
+     : start_(clock::now()), deadline_(start_ + std::chrono::seconds(rlim)), timed_(rlim > 0),
+       memory_limit_(static_cast<size_t>(mlim) << 20), cancelled_(false) { }
+
+    ResourceBudget(const ResourceBudget&) = delete;
+    ResourceBudget& operator=(const ResourceBudget&) = delete;
+
+    /**
+     * @brief Installs a budget on the current thread for the lifetime of the scope
+     */
+    class Scope {
+        ResourceBudget* previous_;
+
+     public:
+        explicit Scope(ResourceBudget& budget) : previous_(current_) {
+            current_ = &budget;
+        }
+
+        ~Scope() {
+            current_ = previous_;
+        }
+
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+    };
+
+    // budget of the current thread, nullptr if none is installed
+    static inline ResourceBudget* current() {
+        return current_;
+    }
+
+    /**
+     * @brief Cancellation point, cheap enough for inner loops
+     * The clock is read only every few hundred calls.
+     * @throw TimeLimitExceeded if the budget of the current thread is exhausted
+     */
+    static inline void checkpoint() {
+        ResourceBudget* budget = current_;
+        if (budget != nullptr && --budget->countdown_ == 0) {
+            budget->countdown_ = interval_;
+            if (budget->expired()) throw TimeLimitExceeded();
+        }
+    }
+
+    // request cancellation of the job, may be called from any thread
+    void cancel() {
+        cancelled_.store(true, std::memory_order_relaxed);
+    }
+
+    // true if the deadline passed or the job was cancelled, does not throw
+    bool expired() const {
+        return cancelled_.load(std::memory_order_relaxed) || (timed_ && clock::now() > deadline_);
+    }
+
+    // charge an allocation, throws if it would exceed the memory limit
+    void charge(size_t bytes) {
+        if (memory_limit_ > 0 && allocated_ + bytes > memory_limit_) {
+            throw MemoryLimitExceeded();
+        }
+        allocated_ += bytes;
+        if (allocated_ > interval_peak_) {
+            interval_peak_ = allocated_;
+            if (allocated_ > peak_) peak_ = allocated_;
+        }
+    }
+
+    // memory that was not charged to this budget (e.g. allocated before it was installed) is not credited
+    void release(size_t bytes) {
+        allocated_ = bytes < allocated_ ? allocated_ - bytes : 0;
+    }
+
+    // seconds since construction
+    double runtime() const {
+        return std::chrono::duration<double>(clock::now() - start_).count();
+    }
+
+    // accounted bytes
+    size_t allocated() const {
+        return allocated_;
+    }
+
+    // peak of accounted bytes
+    size_t peak() const {
+        return peak_;
+    }
+
+    // peak of accounted bytes since the last call, e.g., within a phase
+    size_t takeIntervalPeak() {
+        size_t peak = interval_peak_;
+        interval_peak_ = allocated_;
+        return peak;
+    }
+};
+
+/**
+ * @brief Standard allocator which accounts memory to the budget of the current thread
+ */
+template <typename T>
+struct BudgetAllocator {
+    typedef T value_type;
+
+    BudgetAllocator() noexcept { }
+
+    template <typename U>
+    BudgetAllocator(const BudgetAllocator<U>&) noexcept { }  // NOLINT
+
+    T* allocate(size_t n) {
+        ResourceBudget* budget = ResourceBudget::current();
+        if (budget != nullptr) budget->charge(n * sizeof(T));
+        return std::allocator<T>().allocate(n);
+    }
+
+    void deallocate(T* p, size_t n) noexcept {
+        ResourceBudget* budget = ResourceBudget::current();
+        if (budget != nullptr) budget->release(n * sizeof(T));
+        std::allocator<T>().deallocate(p, n);
+    }
+
+    template <typename U>
+    bool operator==(const BudgetAllocator<U>&) const noexcept {
+        return true;
+    }
+
+    template <typename U>
+    bool operator!=(const BudgetAllocator<U>&) const noexcept {
+        return false;
+    }
+};
+
+// vector whose memory is accounted to the budget of the current thread, e.g., per-variable counters of extractors
+template <typename T>
+using BudgetVector = std::vector<T, BudgetAllocator<T>>;
+
+#endif  // SRC_UTIL_RESOURCEBUDGET_H_
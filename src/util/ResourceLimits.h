@@ -41,6 +41,7 @@ OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWA
     #endif
 #endif
 
+#include "src/util/ResourceBudget.h"
 
 struct ResourceLimitsExceeded : public std::exception {
     const char* what() const throw() {
@@ -48,18 +49,6 @@ struct ResourceLimitsExceeded : public std::exception {
     }
 };
 
-struct TimeLimitExceeded : public std::exception {
-    const char* what() const throw() {
-        return "Exceeded Time Limit";
-    }
-};
-
-struct MemoryLimitExceeded : public std::exception {
-    const char* what() const throw() {
-        return "Exceeded Memory Limit";
-    }
-};
-
 struct FileSizeLimitExceeded : public std::exception {
     const char* what() const throw() {
         return "Exceeded File Size Limit";
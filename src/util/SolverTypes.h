@@ -44,6 +44,7 @@ OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWA
 #include <algorithm>
 #include <functional>
 #include <iostream>
+#include <type_traits>
 
 //=================================================================================================
 // Variables, literals, lifted booleans:
@@ -51,25 +52,19 @@ OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWA
 struct Var {
     unsigned id;
 
-    Var(): id(0) { }
-    explicit Var(uint32_t id_): id(id_) { }
-    Var(const Var& v): Var(v.id) { }
+    constexpr Var(): id(0) { }
+    explicit constexpr Var(uint32_t id_): id(id_) { }
 
-    Var& operator= (const Var& v) {
-        this->id = v.id;
-        return *this;
-    }
-
-    inline operator int() const {
+    inline constexpr operator int() const {
         return id;
     }
 
-    inline Var& operator++ () {  // prefix ++
+    inline constexpr Var& operator++ () {  // prefix ++
         ++id;
         return *this;
     }
 
-    inline Var operator++ (int) {  // postfix ++
+    inline constexpr Var operator++ (int) {  // postfix ++
         Var result(*this);
         ++id;
         return result;
@@ -88,32 +83,32 @@ struct hash<Var> {
 struct Lit {
     unsigned x;
 
-    Lit() : x(0) { }
-    Lit(unsigned var_id, bool sign) : x(2 * var_id + sign) { }
-    Lit(Var var, bool sign) : Lit(var.id, sign) { }
-    explicit Lit(Var var) : Lit(var, false) { }
+    constexpr Lit() : x(0) { }
+    constexpr Lit(unsigned var_id, bool sign) : x(2 * var_id + sign) { }
+    constexpr Lit(Var var, bool sign) : Lit(var.id, sign) { }
+    explicit constexpr Lit(Var var) : Lit(var, false) { }
 
-    inline operator int() const {
+    inline constexpr operator int() const {
         return x;
     }
 
-    inline bool sign() const {
+    inline constexpr bool sign() const {
         return x & 1;
     }
 
-    inline Var var() const {
+    inline constexpr Var var() const {
         return Var(x >> 1);
     }
 
-    inline Lit positive() const {
+    inline constexpr Lit positive() const {
         return Lit(var(), false);
     }
 
-    inline Lit negative() const {
+    inline constexpr Lit negative() const {
         return Lit(var(), true);
     }
 
-    inline int toDimacs() {
+    inline constexpr int toDimacs() const {
         if (sign()) {
             return (-1)*var();
         } else {
@@ -121,36 +116,36 @@ struct Lit {
         }
     }
 
-    inline Lit operator~ () const {
+    inline constexpr Lit operator~ () const {
         Lit q;
         q.x = x ^ 1;
         return q;
     }
 
-    inline Lit operator^ (bool b) const {
+    inline constexpr Lit operator^ (bool b) const {
         Lit q;
         q.x = x ^ (b ? 1 : 0);
         return q;
     }
 
-    inline bool operator== (Lit p) const {
+    inline constexpr bool operator== (Lit p) const {
         return x == p.x;
     }
 
-    inline bool operator!= (Lit p) const {
+    inline constexpr bool operator!= (Lit p) const {
         return x != p.x;
     }
 
-    inline bool operator< (Lit p) const {
+    inline constexpr bool operator< (Lit p) const {
         return x < p.x;
     }  // p and ~p will be adjacent
 
-    inline Lit& operator++ () {
+    inline constexpr Lit& operator++ () {
         ++x;
         return *this;
     }
 
-    inline Lit& operator-- () {
+    inline constexpr Lit& operator-- () {
         --x;
         return *this;
     }
@@ -165,19 +160,19 @@ struct hash<Lit> {
 };
 }
 
-inline Var operator"" _V(unsigned long long n) {
+inline constexpr Var operator"" _V(unsigned long long n) {
     return Var((uint32_t)n);
 }
 
-inline Lit operator"" _L(unsigned long long n) {
+inline constexpr Lit operator"" _L(unsigned long long n) {
     return Lit(Var((uint32_t)n));
 }
 
 
-const Var var_Undef(0);
-const Lit lit_Undef(0, false);
-const Lit lit_True(0, false);
-const Lit lit_False(0, true);
+constexpr Var var_Undef(0);
+constexpr Lit lit_Undef(0, false);
+constexpr Lit lit_True(0, false);
+constexpr Lit lit_False(0, true);
 
 
 //=================================================================================================
@@ -191,49 +186,57 @@ class lbool {
     uint8_t value;
 
  public:
-    explicit lbool(uint8_t v) : value(v) {}
-    explicit lbool(bool x) : value(!x) {}
+    explicit constexpr lbool(uint8_t v) : value(v) {}
+    explicit constexpr lbool(bool x) : value(!x) {}
 
-    bool operator ==(lbool b) const {
+    constexpr bool operator ==(lbool b) const {
         return ((((b.value & 2) & (value & 2)) | ((!(b.value & 2)) & (value == b.value))) != 0);
     }
-    bool operator !=(lbool b) const {
+    constexpr bool operator !=(lbool b) const {
         return !(*this == b);
     }
-    lbool operator ^(bool b) const {
+    constexpr lbool operator ^(bool b) const {
         return value == 2 ? l_Undef : lbool((uint8_t)(value ^ (uint8_t)b));
     }
 
-    lbool operator &&(lbool b) const {
+    constexpr lbool operator &&(lbool b) const {
         uint8_t sel = (this->value << 1) | (b.value << 3);
         uint8_t v = (0xF7F755F4 >> sel) & 3;
         return lbool(v);
     }
 
-    lbool operator ||(lbool b) const {
+    constexpr lbool operator ||(lbool b) const {
         uint8_t sel = (this->value << 1) | (b.value << 3);
         uint8_t v = (0xFCFCF400 >> sel) & 3;
         return lbool(v);
     }
 
-    uint8_t operator |(lbool b) const {
+    constexpr uint8_t operator |(lbool b) const {
         return this->value | b.value;
     }
 
-    uint8_t operator &(lbool b) const {
+    constexpr uint8_t operator &(lbool b) const {
         return this->value & b.value;
     }
 
-    uint8_t operator |(uint8_t b) const {
+    constexpr uint8_t operator |(uint8_t b) const {
         return this->value | b;
     }
 
-    uint8_t operator &(uint8_t b) const {
+    constexpr uint8_t operator &(uint8_t b) const {
         return this->value & b;
     }
 };
 
 
+// Var, Lit and lbool are plain values: containers of them may be copied, filled and relocated with memcpy
+static_assert(std::is_trivially_copyable<Var>::value && sizeof(Var) == sizeof(uint32_t), "Var must be a 32-bit value type");
+static_assert(std::is_trivially_copyable<Lit>::value && sizeof(Lit) == sizeof(uint32_t), "Lit must be a 32-bit value type");
+static_assert(std::is_trivially_copyable<lbool>::value && sizeof(lbool) == sizeof(uint8_t), "lbool must be an 8-bit value type");
+static_assert(std::is_standard_layout<Var>::value && std::is_standard_layout<Lit>::value, "Var and Lit must have standard layout");
+static_assert((~Lit(3_V, false)).toDimacs() == -3 && Lit(3_V, true).var() == 3_V, "Lit encoding");
+
+
 typedef std::vector<Lit> Cl;
 typedef std::vector<Cl*> For;
 
@@ -30,6 +30,7 @@ OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWA
 #include <string>
 
 #include "SolverTypes.h"
+#include "Profile.h"
 
 class ParserException : public std::exception
 {
@@ -71,7 +72,12 @@ class StreamBuffer
             {
                 end = 0;
             }
-            end += archive_read_data(file, buffer + end, buffer_size - end);
+            {
+                PhaseTimer::Measure decompress(PhaseTimer::DECOMPRESS);
+                auto bytes = archive_read_data(file, buffer + end, buffer_size - end);
+                GBDC_PROFILE_COUNT(BYTES_READ, bytes);
+                end += bytes;
+            }
             if (end < buffer_size)
             {
                 std::memset(buffer + end, 0, buffer_size - end);
@@ -289,6 +295,7 @@ public:
                 {
                     pos += static_cast<intptr_t>(end - str);
                     *out = static_cast<int>(number);
+                    GBDC_PROFILE_COUNT(TOKENS, 1);
                     return true;
                 }
                 else
@@ -332,6 +339,7 @@ public:
                 {
                     pos += static_cast<intptr_t>(end - str);
                     *out = static_cast<uint64_t>(number);
+                    GBDC_PROFILE_COUNT(TOKENS, 1);
                     return true;
                 }
                 else
@@ -393,6 +401,7 @@ public:
         }
 
         *out = result;
+        GBDC_PROFILE_COUNT(TOKENS, 1);
         return true;
     }
 
@@ -423,6 +432,7 @@ public:
         }
 
         out = clause;
+        GBDC_PROFILE_COUNT(CLAUSES, 1);
         return true;
     }
 };
@@ -25,6 +25,7 @@ OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWA
 
 #include <iostream>
 #include <string>
+#include <filesystem>
 
 class StreamCompressorException : public std::runtime_error
 {
@@ -34,10 +35,14 @@ public:
     explicit StreamCompressorException(const std::string &msg, archive *arch) : std::runtime_error(msg + ": " + std::string(archive_error_string(arch))) {}
 };
 
+/**
+ * @brief Writes xz compressed files
+ * If size is 0, the entry size is not announced and any amount of data may be written (streaming).
+ */
 class StreamCompressor
 {
-    unsigned size_;
-    unsigned cursor;
+    size_t size_;
+    size_t cursor;
 
     struct archive *arch;
     struct archive_entry *entry;
@@ -46,7 +51,7 @@ class StreamCompressor
     bool closed;
 
 public:
-    StreamCompressor(const char *output, unsigned size = 0) : size_(size), cursor(0), status(0)
+    StreamCompressor(const char *output, size_t size = 0) : size_(size), cursor(0), status(0), closed(false)
     {
         arch = archive_write_new();
         status = archive_write_set_format_raw(arch);
@@ -85,16 +90,16 @@ public:
             close();
     }
 
-    void write(const char *buf, unsigned len)
+    void write(const char *buf, size_t len)
     {
         cursor += len;
-        if (cursor > size_)
+        if (size_ != 0 && cursor > size_)
         {
             throw StreamCompressorException("Attempt to write more than announced");
         }
 
-        int bytes_written = archive_write_data(arch, buf, len);
-        if (bytes_written != len)
+        auto bytes_written = archive_write_data(arch, buf, len);
+        if (bytes_written < 0 || static_cast<size_t>(bytes_written) != len)
         {
             throw StreamCompressorException("Error writing to archive", arch);
         }
@@ -0,0 +1,194 @@
+/**
+ * MIT License
+ * Copyright (c) 2024 Markus Iser
+ */
+
+#ifndef SRC_UTIL_TIMER_H_
+#define SRC_UTIL_TIMER_H_
+
+#include <cstdint>
+#include <cstddef>
+#include <algorithm>
+
+#ifdef _WIN32
+    #include <Windows.h>
+    #include <chrono>
+#else
+    #include <time.h>
+#endif
+
+#include "src/util/ResourceBudget.h"
+
+/**
+ * @brief Nanosecond wall-clock (monotonic) and CPU time (of the calling thread)
+ */
+class Timer {
+    uint64_t wall_;
+    uint64_t cpu_;
+
+ public:
+    Timer() : wall_(wall()), cpu_(cpu()) { }
+
+    // monotonic wall-clock time in nanoseconds
+    static inline uint64_t wall() {
+    #ifdef _WIN32
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+    #else
+        struct timespec ts;
+        clock_gettime(CLOCK_MONOTONIC, &ts);
+        return static_cast<uint64_t>(ts.tv_sec) * 1000000000ULL + ts.tv_nsec;
+    #endif
+    }
+
+    // cpu time of the calling thread in nanoseconds
+    static inline uint64_t cpu() {
+    #ifdef _WIN32
+        FILETIME a, b, c, d;
+        if (GetThreadTimes(GetCurrentThread(), &a, &b, &c, &d) == 0) return 0;
+        uint64_t kernel = static_cast<uint64_t>(c.dwHighDateTime) << 32 | c.dwLowDateTime;
+        uint64_t user = static_cast<uint64_t>(d.dwHighDateTime) << 32 | d.dwLowDateTime;
+        return (kernel + user) * 100;  // 100-nanosecond intervals
+    #else
+        struct timespec ts;
+        clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts);
+        return static_cast<uint64_t>(ts.tv_sec) * 1000000000ULL + ts.tv_nsec;
+    #endif
+    }
+
+    // nanoseconds since construction
+    inline uint64_t wallNs() const {
+        return wall() - wall_;
+    }
+
+    inline uint64_t cpuNs() const {
+        return cpu() - cpu_;
+    }
+
+    // seconds since construction
+    inline double wallSeconds() const {
+        return wallNs() * 1e-9;
+    }
+
+    inline double cpuSeconds() const {
+        return cpuNs() * 1e-9;
+    }
+};
+
+/**
+ * @brief Wall-clock and CPU time per extraction phase
+ *
+ * Phases are measured with PhaseTimer::Measure, which can be nested:
+ * time is always charged to the innermost phase only, such that the phase times add up to the total.
+ * Measurements are taken if a PhaseTimer is installed on the current thread (see Scope), otherwise they are no-ops.
+ * If a ResourceBudget is installed, the peak of accounted memory is recorded per phase, too.
+ */
+class PhaseTimer {
+ public:
+    enum Phase { NONE = 0, DECOMPRESS, PARSE, ANALYZE, STATISTICS, N_PHASES };
+
+    static constexpr const char* names[N_PHASES] = { "other", "decompress", "parse", "analyze", "statistics" };
+
+ private:
+    static inline thread_local PhaseTimer* current_ = nullptr;
+
+    uint64_t wall_[N_PHASES] = { };
+    uint64_t cpu_[N_PHASES] = { };
+    size_t peak_[N_PHASES] = { };
+
+    Phase phase_ = NONE;  // innermost active phase
+    uint64_t wall_mark_;  // start of the current time slice
+    uint64_t cpu_mark_;
+
+    // charge time since last switch to the active phase, activate given phase
+    inline Phase enter(Phase phase) {
+        uint64_t wall = Timer::wall(), cpu = Timer::cpu();
+        wall_[phase_] += wall - wall_mark_;
+        cpu_[phase_] += cpu - cpu_mark_;
+        ResourceBudget* budget = ResourceBudget::current();
+        if (budget != nullptr) peak_[phase_] = std::max(peak_[phase_], budget->takeIntervalPeak());
+        wall_mark_ = wall;
+        cpu_mark_ = cpu;
+        Phase previous = phase_;
+        phase_ = phase;
+        return previous;
+    }
+
+ public:
+    PhaseTimer() : wall_mark_(Timer::wall()), cpu_mark_(Timer::cpu()) { }
+
+    /**
+     * @brief Installs a phase timer on the current thread for the lifetime of the scope
+     */
+    class Scope {
+        PhaseTimer& timer_;
+        PhaseTimer* previous_;
+
+     public:
+        explicit Scope(PhaseTimer& timer) : timer_(timer), previous_(current_) {
+            current_ = &timer;
+            timer_.wall_mark_ = Timer::wall();  // time outside of scopes is not charged
+            timer_.cpu_mark_ = Timer::cpu();
+        }
+
+        ~Scope() {
+            timer_.enter(timer_.phase_);  // close time slice
+            current_ = previous_;
+        }
+
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+    };
+
+    /**
+     * @brief Charges the time of its lifetime to the given phase of the installed phase timer
+     */
+    class Measure {
+        PhaseTimer* timer_;
+        Phase previous_;
+
+     public:
+        explicit Measure(Phase phase) : timer_(current_), previous_(NONE) {
+            if (timer_ != nullptr) previous_ = timer_->enter(phase);
+        }
+
+        ~Measure() {
+            if (timer_ != nullptr) timer_->enter(previous_);
+        }
+
+        Measure(const Measure&) = delete;
+        Measure& operator=(const Measure&) = delete;
+    };
+
+    static inline PhaseTimer* current() {
+        return current_;
+    }
+
+    // nanoseconds spent in the given phase
+    inline uint64_t wallNs(Phase phase) const {
+        return wall_[phase];
+    }
+
+    inline uint64_t cpuNs(Phase phase) const {
+        return cpu_[phase];
+    }
+
+    // peak of accounted memory in the given phase (bytes)
+    inline size_t peakBytes(Phase phase) const {
+        return peak_[phase];
+    }
+
+    // nanoseconds spent in all phases
+    uint64_t wallNs() const {
+        uint64_t sum = 0;
+        for (unsigned p = 0; p < N_PHASES; ++p) sum += wall_[p];
+        return sum;
+    }
+
+    uint64_t cpuNs() const {
+        uint64_t sum = 0;
+        for (unsigned p = 0; p < N_PHASES; ++p) sum += cpu_[p];
+        return sum;
+    }
+};
+
+#endif  // SRC_UTIL_TIMER_H_
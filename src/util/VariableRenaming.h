@@ -0,0 +1,78 @@
+/**
+ * MIT License
+ * Copyright (c) 2024 Markus Iser
+ */
+
+#ifndef SRC_UTIL_VARIABLERENAMING_H_
+#define SRC_UTIL_VARIABLERENAMING_H_
+
+#include <vector>
+#include <unordered_map>
+#include <algorithm>
+
+#include "src/util/SolverTypes.h"
+
+/**
+ * @brief Online renaming of variables to 1..n in order of first occurrence
+ *
+ * Small variable ids are mapped through a dense table which grows with the number of renamed variables.
+ * Ids which are far beyond that (sparse id spaces like in `p cnf 2000000000`) go to a hash map,
+ * such that memory is proportional to the number of distinct variables and not to the largest id.
+ */
+class VariableRenaming {
+    std::vector<unsigned> dense;  // dense[id] = new name, 0 if unnamed
+    std::unordered_map<unsigned, unsigned> sparse;
+    std::vector<Var> original;  // original[name] = id
+
+    // ids up to this bound are considered dense
+    inline size_t denseLimit() const {
+        return std::max<size_t>(1 << 16, 8 * original.size());
+    }
+
+ public:
+    VariableRenaming() : dense(), sparse(), original(1, var_Undef) { }
+
+    inline Var rename(Var var) {
+        unsigned id = var.id;
+        if (id < dense.size()) {
+            if (dense[id] != 0) return Var(dense[id]);
+        }
+        if (!sparse.empty()) {
+            auto it = sparse.find(id);
+            if (it != sparse.end()) return Var(it->second);
+        }
+        unsigned name = original.size();
+        original.push_back(var);
+        if (id < dense.size()) {
+            dense[id] = name;
+        } else if (id < denseLimit()) {
+            dense.resize(std::max<size_t>(id + 1, 2 * dense.size()), 0);
+            dense[id] = name;
+        } else {
+            sparse.emplace(id, name);
+        }
+        return Var(name);
+    }
+
+    inline Lit rename(Lit lit) {
+        return Lit(rename(lit.var()), lit.sign());
+    }
+
+    // original id of renamed variable
+    inline Var originalName(Var var) const {
+        return original[var];
+    }
+
+    // number of renamed variables
+    inline size_t size() const {
+        return original.size() - 1;
+    }
+
+    void clear() {
+        dense.clear();
+        sparse.clear();
+        original.resize(1);
+    }
+};
+
+#endif  // SRC_UTIL_VARIABLERENAMING_H_
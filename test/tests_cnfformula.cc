@@ -0,0 +1,194 @@
+#include <stdio.h>
+#include <cstdio>
+#include <fstream>
+#include <string>
+
+#include "src/util/CNFFormula.h"
+#include "src/util/ResourceBudget.h"
+#include "src/util/Timer.h"
+#include "src/util/Profile.h"
+#include "test/Util.h"
+
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include "doctest.h"
+
+static std::string write_cnf(const char *content)
+{
+    auto tmp_file = tmp_filename("/tmp", ".cnf");
+    std::ofstream out(tmp_file);
+    out << content;
+    out.close();
+    return tmp_file;
+}
+
+TEST_CASE("CNFFormula")
+{
+    SUBCASE("Duplicate clauses are kept by default")
+    {
+        auto tmp_file = write_cnf("p cnf 3 4\n1 -2 0\n-2 1 0\n3 0\n1 1 -2 0\n");
+        CNFFormula formula(tmp_file.c_str());
+        CHECK(formula.nClauses() == 4);
+        CHECK(formula.nDuplicates() == 0);
+        remove(tmp_file.c_str());
+    }
+
+    SUBCASE("Duplicate clauses are removed after sanitization")
+    {
+        auto tmp_file = write_cnf("p cnf 3 6\n1 -2 0\n-2 1 0\n3 0\n1 1 -2 0\n1 -1 0\n-3 0\n3 0\n");
+        CNFFormula formula(tmp_file.c_str(), true);
+        CHECK(formula.nClauses() == 3);
+        CHECK(formula.nDuplicates() == 3);
+        CHECK(*formula[0] == Cl({Lit(1, false), Lit(2, true)}));
+        CHECK(*formula[1] == Cl({Lit(3, false)}));
+        CHECK(*formula[2] == Cl({Lit(3, true)}));
+        remove(tmp_file.c_str());
+    }
+
+    SUBCASE("Deduplication scales beyond initial table capacity")
+    {
+        CNFFormula formula;
+        formula.enableDeduplication();
+        for (unsigned round = 0; round < 2; ++round) {
+            for (unsigned v = 1; v <= 5000; ++v) {
+                formula.readClause({ Lit(v, false), Lit(v + 1, true) });
+            }
+        }
+        CHECK(formula.nClauses() == 5000);
+        CHECK(formula.nDuplicates() == 5000);
+    }
+
+    SUBCASE("Online renaming of sparse variable ids")
+    {
+        auto tmp_file = write_cnf("p cnf 2000000000 3\n2000000000 -7 0\n7 1999999999 0\n-2000000000 -1999999999 0\n");
+        CNFFormula formula;
+        formula.enableRenaming();
+        formula.readDimacsFromFile(tmp_file.c_str());
+        CHECK(formula.nVars() == 3);
+        CHECK(formula.nClauses() == 3);
+        CHECK(*formula[0] == Cl({Lit(1, false), Lit(2, true)}));
+        CHECK(*formula[1] == Cl({Lit(2, false), Lit(3, false)}));
+        CHECK(*formula[2] == Cl({Lit(1, true), Lit(3, true)}));
+        CHECK(formula.originalName(Var(1)) == Var(2000000000));
+        CHECK(formula.originalName(Var(2)) == Var(7));
+        CHECK(formula.originalName(Var(3)) == Var(1999999999));
+        remove(tmp_file.c_str());
+    }
+
+    SUBCASE("Online renaming skips variables of tautologies")
+    {
+        auto tmp_file = write_cnf("p cnf 2000000000 3\n5 -5 0\n2000000000 -7 0\n7 1999999999 0\n");
+        CNFFormula formula;
+        formula.enableRenaming();
+        formula.readDimacsFromFile(tmp_file.c_str());
+        CHECK(formula.nVars() == 3);
+        CHECK(formula.nClauses() == 2);
+        CHECK(*formula[0] == Cl({Lit(1, false), Lit(2, true)}));
+        CHECK(*formula[1] == Cl({Lit(2, false), Lit(3, false)}));
+        CHECK(formula.originalName(Var(1)) == Var(2000000000));
+        CHECK(formula.originalName(Var(2)) == Var(7));
+        CHECK(formula.originalName(Var(3)) == Var(1999999999));
+        remove(tmp_file.c_str());
+    }
+
+    SUBCASE("Post-pass renaming keeps clauses sorted")
+    {
+        CNFFormula formula;
+        formula.readClause({ Lit(9, false), Lit(4, true) });
+        formula.readClause({ Lit(4, false), Lit(2, false) });
+        CHECK(formula.nVars() == 9);
+        formula.normalizeVariableNames();
+        CHECK(formula.nVars() == 3);
+        CHECK(*formula[0] == Cl({Lit(1, true), Lit(2, false)}));
+        CHECK(*formula[1] == Cl({Lit(1, false), Lit(3, false)}));
+    }
+}
+
+TEST_CASE("ResourceBudget")
+{
+    auto tmp_file = write_cnf("p cnf 3 3\n1 -2 0\n2 3 0\n-1 -3 0\n");
+
+    SUBCASE("Clause memory is accounted to the budget of the current thread")
+    {
+        ResourceBudget budget;
+        {
+            ResourceBudget::Scope scope(budget);
+            CNFFormula formula(tmp_file.c_str());
+            CHECK(budget.allocated() >= 6 * sizeof(Lit));
+        }
+        CHECK(budget.allocated() == 0);
+        CHECK(budget.peak() >= 6 * sizeof(Lit));
+        CHECK(ResourceBudget::current() == nullptr);
+    }
+
+    SUBCASE("Exceeding the memory limit throws")
+    {
+        ResourceBudget budget(0, 1);
+        ResourceBudget::Scope scope(budget);
+        CNFFormula formula;
+        std::vector<Lit> clause;
+        for (unsigned v = 1; v <= (1 << 10); ++v) clause.push_back(Lit(v, false));
+        CHECK_NOTHROW(formula.readClause(clause.begin(), clause.end()));
+        for (unsigned v = (1 << 10) + 1; v <= (1 << 19); ++v) clause.push_back(Lit(v, false));
+        CHECK_THROWS_AS(formula.readClause(clause.begin(), clause.end()), MemoryLimitExceeded);
+        CHECK(formula.nClauses() == 1);
+        CHECK_THROWS_AS((std::vector<Lit, BudgetAllocator<Lit>>(1 << 20)), MemoryLimitExceeded);
+    }
+
+    SUBCASE("Cancelled budget throws at checkpoints")
+    {
+        ResourceBudget budget;
+        ResourceBudget::Scope scope(budget);
+        budget.cancel();
+        CHECK(budget.expired());
+        CHECK_THROWS_AS(CNFFormula(tmp_file.c_str()), TimeLimitExceeded);
+    }
+
+    remove(tmp_file.c_str());
+}
+
+TEST_CASE("PhaseTimer")
+{
+    auto tmp_file = write_cnf("p cnf 3 3\n1 -2 0\n2 3 0\n-1 -3 0\n");
+
+    SUBCASE("Nested phases are charged exclusively")
+    {
+        PhaseTimer timer;
+        {
+            PhaseTimer::Scope scope(timer);
+            CNFFormula formula(tmp_file.c_str());
+            PhaseTimer::Measure statistics(PhaseTimer::STATISTICS);
+        }
+        CHECK(PhaseTimer::current() == nullptr);
+        CHECK(timer.wallNs(PhaseTimer::DECOMPRESS) > 0);
+        CHECK(timer.wallNs(PhaseTimer::PARSE) > 0);
+        CHECK(timer.wallNs(PhaseTimer::ANALYZE) == 0);
+        CHECK(timer.wallNs() == timer.wallNs(PhaseTimer::NONE) + timer.wallNs(PhaseTimer::DECOMPRESS)
+            + timer.wallNs(PhaseTimer::PARSE) + timer.wallNs(PhaseTimer::STATISTICS));
+    }
+
+    SUBCASE("Measurements without installed timer are no-ops")
+    {
+        PhaseTimer timer;
+        CNFFormula formula(tmp_file.c_str());
+        CHECK(timer.wallNs() == 0);
+        CHECK(timer.cpuNs() == 0);
+    }
+
+    remove(tmp_file.c_str());
+}
+
+TEST_CASE("Profile")
+{
+    auto tmp_file = write_cnf("p cnf 3 3\n1 -2 0\n2 3 0\n-1 -3 0\n");
+    Profile profile;
+    {
+        Profile::Scope scope(profile);
+        CNFFormula formula(tmp_file.c_str());
+    }
+    CHECK(profile.timer().wallNs(PhaseTimer::PARSE) > 0);
+    CHECK(profile.timer().peakBytes(PhaseTimer::PARSE) >= 6 * sizeof(Lit));
+    CHECK(profile.counter(Profile::CLAUSES) == (Profile::counters_enabled ? 3 : 0));
+    CHECK(profile.counter(Profile::TOKENS) == (Profile::counters_enabled ? 9 : 0));
+    CHECK(profile.json().find("\"parse\": {\"wall_ns\": ") != std::string::npos);
+    remove(tmp_file.c_str());
+}
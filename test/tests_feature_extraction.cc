@@ -1,26 +1,35 @@
 #include <iostream>
+#include <algorithm>
 #include <array>
 #include <cstdio>
 #include <unordered_map>
 #include <filesystem>
+#include <fstream>
+#include <random>
 #include <string>
+#include <vector>
 
 #include "src/util/CaptureDistribution.h"
 #include "src/extract/CNFBaseFeatures.h"
 #include "src/extract/OPBBaseFeatures.h"
 #include "src/extract/WCNFBaseFeatures.h"
 #include "src/extract/CNFGateFeatures.h"
+#include "src/extract/gates/GateAnalyzer.h"
+#include "src/extract/gates/GateFile.h"
+#include "src/extract/gates/SemanticFilter.h"
+#include "src/identify/ISOHash.h"
+#include "src/generate/Generators.h"
 
 #include "test/Util.h"
 
 #define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
 #include "doctest.h"
 
-template <typename Extractor>
-void extract(const char *test_file, const char *expected_record_file)
+template <typename Extractor, typename Instance>
+void extract(const Instance &test_instance, const char *expected_record_file)
 {
     auto expected_record = record_to_map<double>(expected_record_file);
-    Extractor stats(test_file);
+    Extractor stats(test_instance);
     stats.extract();
     auto record = stats.getFeatures();
     auto names = stats.getNames();
@@ -50,6 +59,15 @@ TEST_CASE("Feature extraction")
         extract<CNF::GateFeatures>(test_file.c_str(), expected_record_file.c_str());
     }
 
+    SUBCASE("CNF base and gates from loaded formula")
+    {
+        const auto test_file = test_dir + "cnf_test.cnf.xz";
+        CNFFormula formula(test_file.c_str(), true);
+        extract<CNF::BaseFeatures>(formula, (records_dir + "cnf_base.txt").c_str());
+        extract<CNF::GateFeatures>(formula, (records_dir + "cnf_gates.txt").c_str());
+        CHECK(CNF::isohash(formula) == CNF::isohash(test_file.c_str()));
+    }
+
     SUBCASE("WCNF base")
     {
         const auto test_file = test_dir + "wcnf_test.wcnf.xz";
@@ -64,3 +82,326 @@ TEST_CASE("Feature extraction")
         extract<OPB::BaseFeatures>(test_file.c_str(), expected_record_file.c_str());
     }
 }
+
+// generated circuit of wide multiplexers (see generate::TseitinCircuit), seven inputs are too many for truth tables
+static void multiplexers(CNFFormula& formula, unsigned n_inputs, unsigned n_gates)
+{
+    generate::Parameters p;
+    p.inputs = n_inputs;
+    p.gates = n_gates;
+    p.wide_mux_ratio = 1;
+    p.window = n_inputs + n_gates;
+    const std::string file = tmp_filename("/tmp", ".cnf");
+    {
+        InstanceWriter out(file.c_str());
+        generate::write("circuit", p, out);
+    }
+    formula.readDimacsFromFile(file.c_str());
+    std::remove(file.c_str());
+}
+
+TEST_CASE("Parallel semantic gate checks")
+{
+    CNFFormula formula;
+    multiplexers(formula, 20, 300);
+    GateAnalyzer<> serial(formula, true, true, formula.nVars() / 3, 0, 1);
+    serial.analyze();
+    GateAnalyzer<> parallel(formula, true, true, formula.nVars() / 3, 0, 4);
+    parallel.analyze();
+    const GateFormula& expected = serial.getGateFormula();
+    GateFormula actual = parallel.releaseGateFormula();
+    CHECK(expected.nGates() == actual.nGates());
+    unsigned n_generic = 0;
+    for (unsigned v = 1; v <= formula.nVars(); ++v) {
+        const Gate& gate = expected.getGate(Lit(Var(v), false));
+        CHECK(gate.type == actual.getGate(Lit(Var(v), false)).type);
+        Span<const Lit> inp = expected.inp(gate);
+        Span<const Lit> actual_inp = actual.inp(actual.getGate(Lit(Var(v), false)));
+        CHECK(std::equal(inp.begin(), inp.end(), actual_inp.begin(), actual_inp.end()));
+        if (gate.type == GENERIC) ++n_generic;
+    }
+    CHECK(n_generic > 0);
+}
+
+TEST_CASE("Released gate formula")
+{
+    CNFFormula formula;
+    multiplexers(formula, 20, 50);
+    GateAnalyzer<> analyzer(formula, true, true, formula.nVars() / 3);
+    analyzer.analyze();
+    unsigned n_gates = analyzer.getGateFormula().nGates();
+    GateFormula gates = analyzer.releaseGateFormula();
+    CHECK(gates.nGates() == n_gates);
+    for (const Gate& gate : gates) {
+        if (!gate.isDefined()) continue;
+        CHECK(gates.fwd(gate).size() > 0);
+        CHECK(gates.inp(gate).size() > 0);
+    }
+    unsigned n_roots = gates.nRoots() + gates.remainder.size();
+    gates.normalizeRoots();
+    GateFormula normalized(std::move(gates));  // takes ownership of the clauses of the artificial root
+    CHECK(normalized.hasArtificialRoot());
+    CHECK(!gates.hasArtificialRoot());
+    CHECK(normalized.fwd(normalized.getGate(normalized.getRoot())).size() == n_roots);
+}
+
+static bool same_clauses(ClauseSpan expected, ClauseSpan actual) {
+    return std::equal(expected.begin(), expected.end(), actual.begin(), actual.end(), [] (const Cl* a, const Cl* b) {
+        Cl sorted(*a);
+        std::sort(sorted.begin(), sorted.end());
+        return sorted == *b;
+    });
+}
+
+static void check_round_trip(const GateFormula& expected) {
+    std::string file = tmp_filename("/tmp", ".gates");
+    GateWriter writer(file.c_str());
+    writer.write(expected);
+    writer.close();
+    GateReader reader(file.c_str());
+    std::remove(file.c_str());
+    const GateFormula& actual = reader.getGateFormula();
+    REQUIRE(actual.nVars() == expected.nVars());
+    CHECK(actual.nGates() == expected.nGates());
+    CHECK(same_clauses(expected.roots, actual.roots));
+    CHECK(same_clauses(expected.remainder, actual.remainder));
+    for (unsigned v = 0; v < expected.nVars(); ++v) {
+        const Gate& gate = expected[Var(v)];
+        const Gate& other = actual[Var(v)];
+        CHECK(gate.out == other.out);
+        CHECK(gate.type == other.type);
+        CHECK(gate.notMono == other.notMono);
+        Span<const Lit> inp = expected.inp(gate), other_inp = actual.inp(other);
+        CHECK(std::equal(inp.begin(), inp.end(), other_inp.begin(), other_inp.end()));
+        CHECK(same_clauses(expected.fwd(gate), actual.fwd(other)));
+        CHECK(same_clauses(expected.bwd(gate), actual.bwd(other)));
+    }
+    CHECK(expected.inputs == actual.inputs);
+}
+
+TEST_CASE("Gate structure file")
+{
+    SUBCASE("Recognized gates")
+    {
+        CNFFormula formula((test_dir + "cnf_test.cnf.xz").c_str(), true);
+        GateAnalyzer<> analyzer(formula, true, true, formula.nVars() / 3);
+        analyzer.analyze();
+        check_round_trip(analyzer.getGateFormula());
+    }
+
+    SUBCASE("Normalized roots")
+    {
+        CNFFormula formula;
+        multiplexers(formula, 20, 50);
+        GateAnalyzer<> analyzer(formula, true, true, formula.nVars() / 3);
+        analyzer.analyze();
+        GateFormula gates = analyzer.releaseGateFormula();
+        gates.normalizeRoots();
+        check_round_trip(gates);
+    }
+
+    SUBCASE("Invalid list sizes")
+    {
+        // AND gate with output 2 and more than 2^62 inputs
+        std::string file = tmp_filename("/tmp", ".gates");
+        std::string content = "gates 1 3 0 1 0\n";
+        content += static_cast<char>(0);
+        content += static_cast<char>(GateFile::zigzag(Lit(Var(2), false), lit_Undef));
+        content += std::string(8, static_cast<char>(0xFF)) + static_cast<char>(0x40);
+        FILE* out = fopen(file.c_str(), "wb");
+        fwrite(content.data(), 1, content.size(), out);
+        fclose(out);
+        CHECK_THROWS_AS(GateReader(file.c_str()), std::runtime_error);
+        std::remove(file.c_str());
+    }
+}
+
+TEST_CASE("Aborted semantic gate checks")
+{
+    CNFFormula formula;
+    multiplexers(formula, 20, 300);
+    GateAnalyzer<> unlimited(formula, true, true, formula.nVars() / 3);
+    unlimited.analyze();
+    GateAnalyzer<> limited(formula, true, true, formula.nVars() / 3, 0, 1, 1e-9);
+    limited.analyze();
+    CHECK(unlimited.nAborted() == 0);
+    CHECK(limited.nAborted() > 0);
+    CHECK(limited.getGateFormula().nGates() < unlimited.getGateFormula().nGates());
+    // semantic checks of the gate extractor are unlimited by default
+    CNF::GateFeatures stats(formula);
+    stats.extract();
+    CNF::GateFeatures limited_stats(formula, 1e-9);
+    limited_stats.extract();
+    auto names = stats.getNames();
+    auto aborted = std::find(names.begin(), names.end(), "n_aborted") - names.begin();
+    CHECK(stats.getFeatures()[aborted] == 0);
+    CHECK(limited_stats.getFeatures()[aborted] > 0);
+}
+
+TEST_CASE("Partial gate features at the deadline")
+{
+    CNFFormula formula((test_dir + "cnf_test.cnf.xz").c_str(), true);
+    ResourceBudget budget;
+    budget.cancel();  // deadline passed
+    {
+        ResourceBudget::Scope scope(budget);
+        GateAnalyzer<> analyzer(formula, true, true, formula.nVars() / 3);
+        CHECK_THROWS_AS(analyzer.analyze(), TimeLimitExceeded);
+    }
+    CNF::GateFeatures stats(formula);
+    CHECK_NOTHROW(stats.extractWithin(budget));
+    auto names = stats.getNames();
+    auto record = stats.getFeatures();
+    CHECK(record.size() == names.size());
+    auto partial = std::find(names.begin(), names.end(), "partial");
+    REQUIRE(partial != names.end());
+    CHECK(record[partial - names.begin()] == 1);
+}
+
+TEST_CASE("Gate features of renamed variables")
+{
+    // monotonic and-gate 2000000 = 1000000 & 7 with root 2000000
+    const std::string file = tmp_filename("/tmp", ".cnf");
+    std::ofstream(file) << "p cnf 2000000 4\n2000000 0\n-2000000 1000000 0\n-2000000 7 0\n2000000 -1000000 -7 0\n";
+    CNF::GateFeatures sparse(file.c_str());
+    sparse.extract();
+    CNF::GateFeatures renamed(file.c_str(), 0, true);
+    renamed.extract();
+    std::remove(file.c_str());
+    auto names = renamed.getNames();
+    auto expected = sparse.getFeatures();
+    auto actual = renamed.getFeatures();
+    for (unsigned i = 0; i < names.size(); ++i) {
+        if (names[i] == "n_vars") {
+            CHECK(expected[i] == 2000000);
+            CHECK(actual[i] == 3);
+        } else if (names[i] == "n_none") {
+            CHECK(actual[i] == 2);
+        } else if (names[i] == "n_gates" || names[i] == "n_mono" || names[i] == "n_roots") {
+            CHECK(actual[i] == expected[i]);
+            CHECK(actual[i] == 1);
+        }
+    }
+}
+
+TEST_CASE("Memory limit of streaming base features")
+{
+    const auto test_file = test_dir + "00076733bdbce94d7e44eca84f1425f0-vlsat2_16297_1562268.dimacs.cnf.xz";
+    ResourceBudget limited(0, 1);
+    CNF::BaseFeatures stats(test_file.c_str());
+    CHECK_THROWS_AS(stats.extractWithin(limited), MemoryLimitExceeded);
+    // per-variable and distribution vectors are accounted for all base feature extractors
+    ResourceBudget cnf, wcnf, opb;
+    CNF::BaseFeatures(test_file.c_str()).extractWithin(cnf);
+    WCNF::BaseFeatures((test_dir + "wcnf_test.wcnf.xz").c_str()).extractWithin(wcnf);
+    OPB::BaseFeatures((test_dir + "opb_test.opb.xz").c_str()).extractWithin(opb);
+    CHECK(cnf.peak() > (1 << 20));
+    CHECK(wcnf.peak() > 0);
+    CHECK(opb.peak() > 0);
+}
+
+// every clause is a root, a gate clause or in the remainder, also with roots beyond the root limit
+template <typename Analyzer>
+static void check_clause_accounting() {
+    for (const char* file : { "cnf_test.cnf.xz", "017ba03ed108f492c9293c7c95e5cae9-multiplier_14bits__miter_14.cnf.xz" }) {
+        CNFFormula formula((test_dir + file).c_str(), true);
+        Analyzer analyzer(formula, true, true, formula.nVars() / 3);
+        analyzer.analyze();
+        const GateFormula& gates = analyzer.getGateFormula();
+        CHECK(gates.nGates() > 0);
+        size_t n_clauses = gates.nRoots() + gates.remainder.size();
+        for (const Gate& gate : gates) n_clauses += gates.fwd(gate).size() + gates.bwd(gate).size();
+        CHECK(n_clauses == formula.nClauses());
+    }
+}
+
+TEST_CASE("Clause accounting of gate analysis")
+{
+    SUBCASE("Default root selection")
+    {
+        check_clause_accounting<GateAnalyzer<>>();
+    }
+    SUBCASE("Prioritized root selection")
+    {
+        check_clause_accounting<GateAnalyzer<PriorityOccurrenceList>>();
+    }
+}
+
+// gate analysis on a shared occurrence index finds the same gates as on an own index and leaves the shared index unchanged
+template <typename Analyzer>
+static void check_shared_occurrences(const CNFFormula& formula, const OccurrenceIndex& shared) {
+    Analyzer own(formula, true, true, formula.nVars() / 3);
+    own.analyze();
+    Analyzer analyzer(formula, true, true, formula.nVars() / 3, 0, 1, 0, &shared);
+    analyzer.analyze();
+    const GateFormula& expected = own.getGateFormula();
+    const GateFormula& actual = analyzer.getGateFormula();
+    CHECK(expected.nGates() == actual.nGates());
+    CHECK(expected.nRoots() == actual.nRoots());
+    for (unsigned v = 1; v <= formula.nVars(); ++v) {
+        CHECK(expected.getGate(Lit(Var(v), false)).type == actual.getGate(Lit(Var(v), false)).type);
+    }
+}
+
+TEST_CASE("Shared occurrence index")
+{
+    CNFFormula formula((test_dir + "cnf_test.cnf.xz").c_str(), true);
+    const OccurrenceIndex shared(formula, true);
+    std::vector<Cl*> entries;
+    for (size_t lit = 0; lit < shared.size(); ++lit) entries.insert(entries.end(), shared[lit].begin(), shared[lit].end());
+    check_shared_occurrences<GateAnalyzer<OccurrenceList>>(formula, shared);
+    check_shared_occurrences<GateAnalyzer<PriorityOccurrenceList>>(formula, shared);
+    check_shared_occurrences<GateAnalyzer<BlockList>>(formula, shared);
+    std::vector<Cl*> after;
+    for (size_t lit = 0; lit < shared.size(); ++lit) after.insert(after.end(), shared[lit].begin(), shared[lit].end());
+    CHECK(entries == after);
+}
+
+TEST_CASE("Semantic filter")
+{
+    CNFFormula formula;
+    Lit o(Var(1), false), s(Var(2), false), a(Var(3), false), b(Var(4), false);
+    // multiplexer o = s ? a : b
+    formula.readClause({ ~o, ~s, a });
+    formula.readClause({ ~o, s, b });
+    formula.readClause({ o, ~s, ~a });
+    formula.readClause({ o, s, ~b });
+    std::vector<Cl*> fwd(formula.begin(), formula.begin() + 2), bwd(formula.begin() + 2, formula.end());
+    SemanticFilter filter(formula.nVars());
+    CHECK(filter.truthTable(o, fwd, bwd) == 20);
+    bwd.pop_back();  // o undefined if s is false
+    CHECK(filter.truthTable(o, fwd, bwd) == 10);
+    CHECK(filter.propagate(o, fwd, bwd) == 0);
+    // o = a & b with redundant clause
+    formula.readClause({ ~o, a });
+    formula.readClause({ ~o, b });
+    formula.readClause({ o, ~a, ~b, s });
+    formula.readClause({ o, ~a, ~b });
+    fwd.assign(formula.begin() + 4, formula.begin() + 6);
+    bwd.assign(formula.begin() + 6, formula.end());
+    CHECK(filter.propagate(o, fwd, bwd) == 20);
+    bwd.pop_back();  // o undefined if s is true
+    CHECK(filter.propagate(o, fwd, bwd) == 10);
+}
+
+TEST_CASE("Distribution from histogram")
+{
+    std::mt19937 rng(42);
+    std::vector<unsigned> distribution;
+    std::vector<uint64_t> histogram;
+    for (unsigned i = 0; i < 1000; ++i) {
+        unsigned value = rng() % 10 + (i % 3 == 0 ? 20 : 0);
+        distribution.push_back(value);
+        add_to_histogram(histogram, value);
+    }
+    std::vector<double> expected, actual;
+    push_distribution(expected, distribution);
+    push_histogram(actual, histogram);
+    REQUIRE(expected.size() == actual.size());
+    for (unsigned i = 0; i < expected.size(); ++i) {
+        CHECK(fequal(expected[i], actual[i]));
+    }
+    actual.clear();
+    push_histogram(actual, std::vector<uint64_t>());
+    CHECK(actual == std::vector<double>(5, 0));
+}
@@ -7,12 +7,52 @@
 
 #include "test/Util.h"
 #include "src/extract/CNFBaseFeatures.h"
+#include "src/extract/CNFInstance.h"
+#include "src/identify/ISOHash.h"
 
 #define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
 #include "doctest.h"
 
 namespace fs = std::filesystem;
 
+TEST_CASE("Identities of a loaded instance")
+{
+    // one duplicate clause and one tautology, which sanitization removes
+    const std::string file = "test/resources/unsanitized.cnf";
+    const std::string copy = tmp_filename("/tmp", ".cnf");
+    fs::copy_file(file, copy);
+    CNF::Instance instance(copy);
+    fs::remove(copy);  // the file is parsed once, identities are computed from the loaded instance
+    CHECK(instance.formula().nClauses() == 3);
+
+    CNF::BaseFeatures raw(file.c_str());
+    raw.extract();
+    std::unique_ptr<IExtractor> loaded = instance.baseFeatures();
+    loaded->extract();
+    CHECK(loaded->getNames() == raw.getNames());
+    CHECK(loaded->getFeatures() == raw.getFeatures());
+    CHECK(raw.getFeatures()[0] == 5);  // clauses
+
+    CHECK(instance.isohash() == CNF::isohash(file.c_str()));
+    CHECK(instance.isohash() != CNF::isohash(instance.formula()));
+
+    const std::string compressed = "test/resources/test_files/cnf_test.cnf.xz";
+    CNF::Instance other(compressed);
+    CNF::BaseFeatures expected(compressed.c_str());
+    expected.extract();
+    std::unique_ptr<IExtractor> actual = other.baseFeatures();
+    actual->extract();
+    CHECK(actual->getFeatures() == expected.getFeatures());
+    CHECK(other.isohash() == CNF::isohash(compressed.c_str()));
+
+    // renaming applies to the formula, identities of the file are unchanged
+    CNF::Instance renamed(compressed, true);
+    CHECK(renamed.formula().isRenamed());
+    CHECK(renamed.formula().nClauses() == other.formula().nClauses());
+    CHECK(renamed.formula().nVars() <= other.formula().nVars());
+    CHECK(renamed.isohash() == other.isohash());
+}
+
 // TEST_CASE("GBDLib")
 // {
 //     SUBCASE("BaseFeature_Names")
@@ -4,6 +4,8 @@
 #include <fstream>
 #include "src/util/StreamBuffer.h"
 #include "src/util/StreamCompressor.h"
+#include "src/util/CNFFormula.h"
+#include "src/generate/Generators.h"
 #include "test/Util.h"
 
 #define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
@@ -59,4 +61,27 @@ TEST_CASE("StreamCompressor")
         CHECK(cnf_cl_read == tmp_cl_read);
         remove(tmp_file.c_str());
     }
+
+    SUBCASE("Stream generated instance of unannounced size to archive")
+    {
+        auto tmp_file = tmp_filename("test/resources", ".cnf.xz");
+        generate::Parameters p;
+        p.inputs = 50;
+        p.gates = 20000;
+        {
+            InstanceWriter out(tmp_file.c_str());
+            generate::write("circuit", p, out);
+            CHECK(out.size() > 1 << 16);  // more than one buffer
+        }
+        StreamBuffer header(tmp_file.c_str());
+        header.skipWhitespace();
+        header.skipString("p cnf");
+        int vars, clauses;
+        header.readInteger(&vars);
+        header.readInteger(&clauses);
+        CNFFormula formula(tmp_file.c_str());
+        CHECK(vars == 20050);
+        CHECK(formula.nClauses() == static_cast<size_t>(clauses));
+        remove(tmp_file.c_str());
+    }
 }